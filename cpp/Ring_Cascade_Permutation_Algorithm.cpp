@@ -3,6 +3,30 @@
  * @brief High-performance Ring-Cascade-Permutation-Algorithm (Optimized for Benchmarking)
  * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
  * @license Licensed under the MIT License.
+ * @details
+ * Usage: ./rcpa_test <n> [begin end] [--elem=int|u16|u8|all] [--isa=NAME]
+ *                       [--checkpoint=FILE [--every=BLOCKS] [--resume]] [--text[=space|comma]]
+ *                       [--verify] [--perf]
+ *   begin end : enumerate only the RCPA index range [begin, end)
+ *   --elem    : element type of the D rows (default int); "all" prints one
+ *               REPORT block per type
+ *   --isa     : force the scalar|sse4.2|avx2|avx512 kernel variant instead of
+ *               the best one this CPU supports (rcpa_dispatch.hpp)
+ *   --checkpoint : save the position and ring checksum to FILE every BLOCKS
+ *               ring blocks (default 2^24) and on SIGTERM/SIGINT, which exit
+ *               with status 75; --resume continues from FILE if it exists
+ *               (rcpa_checkpoint.hpp)
+ *   --text    : print every permutation, one per line, for any n (default
+ *               only for n <= LITTLE_NUMBER) through rcpa_text.hpp; not
+ *               with --checkpoint or --verify
+ *   --verify  : check on all cores that each of the N! permutations is
+ *               generated exactly once (rcpa_coverage.hpp); exits with status
+ *               1 on any missing or repeated permutation
+ *   --perf    : count cycles, instructions, branch misses and L1D misses /
+ *               stores around the generation loop and report them per
+ *               permutation and per ring block (rcpa_perf.hpp)
+ * Built with -DRCPA_OPCOUNT the report adds carries per level, cascade bytes
+ * and ring updates per permutation (rcpa_opcount.hpp).
  */
 
 #include <cstdio>
@@ -10,6 +34,18 @@
 #include <ctime>
 #include <chrono>
 #include <cstdlib>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "rcpa.hpp"
+#include "rcpa_checkpoint.hpp"
+#include "rcpa_coverage.hpp"
+#include "rcpa_dispatch.hpp"
+#include "rcpa_opcount.hpp"
+#include "rcpa_parallel.hpp"
+#include "rcpa_perf.hpp"
+#include "rcpa_text.hpp"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -18,98 +54,171 @@
     #include <pthread.h>
 #endif
 
-int main(int argc, char* argv[]) {
-    // Permutations will be printed only if n_val <= LITTLE_NUMBER
-    const int LITTLE_NUMBER = 5;
+// Permutations will be printed only if n <= LITTLE_NUMBER or with --text
+const int LITTLE_NUMBER = 5;
 
-    // --- Parse Command Line Argument ---
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <n>\n", argv[0]);
-        return 1;
-    }
-    int n_val = std::atoi(argv[1]);
-    if (n_val <= 3) {
-        fprintf(stderr, "Error: n must be greater than 3 for RCPA logic.\n");
-        return 1;
-    }
+// Exit status after a stop signal: checkpoint saved, rerun with --resume.
+const int EXIT_RESUMABLE = 75;
 
-    const int current_n = n_val;
-    const int curr_last = current_n - 1;
-    const int curr_2nd_last = current_n - 2;
-    const int curr_3rd_last = current_n - 3;
+struct RunConfig {
+    int n;
+    bool use_range;
+    unsigned long long range_begin;
+    unsigned long long range_end;
+    rcpa::Isa isa;
+    const char* checkpoint_path;
+    unsigned long long checkpoint_every;
+    bool resume;
+    char text_sep;  // 0: print only for n <= LITTLE_NUMBER
+    bool verify;
+    bool perf;
+};
 
-    // --- Set CPU Affinity (Consistent with A-Suite) ---
-#ifdef _WIN32
-    DWORD_PTR mask = 8; // Core 3
-    SetThreadAffinityMask(GetCurrentThread(), mask);
-#else
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(1, &cpuset); // Core 1
-    sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-#endif
+// Ring checksum kept in the checkpoint state, so it survives a restart.
+template <typename T>
+struct CheckpointChecksum {
+    rcpa::CheckpointState* st;
 
-    int* C = (int*)std::calloc(current_n, sizeof(int));
-    int* D_flat = (int*)std::calloc(current_n * (3 * current_n), sizeof(int));
-    
-    // Macro for dynamic D[i][j] access
-    #define D_PTR(i, j) (D_flat + (i) * (3 * current_n) + (j))
+    void operator()(const T* ring) {
+        st->checksum += static_cast<unsigned long long>(ring[0]) * st->n + ring[st->n - 1];
+        st->rings++;
+    }
+};
+
+// Full enumeration with checkpoints; returns false if stopped by a signal or
+// the checkpoint cannot be read or written.
+template <typename T>
+bool run_rcpa_checkpointed(const RunConfig& cfg, const char* elem_name) {
+    const int current_n = cfg.n;
+    rcpa::CheckpointState st = rcpa::new_checkpoint(current_n, elem_name, cfg.checkpoint_every);
+    if (cfg.resume) {
+        FILE* existing = fopen(cfg.checkpoint_path, "rb");
+        if (existing != NULL) {
+            fclose(existing);
+            if (!rcpa::load_checkpoint(cfg.checkpoint_path, st)) {
+                fprintf(stderr, "Error: checkpoint %s is corrupt.\n", cfg.checkpoint_path);
+                return false;
+            }
+            if (st.n != current_n || std::strcmp(st.elem, elem_name) != 0) {
+                fprintf(stderr, "Error: checkpoint %s is for n=%d %s.\n", cfg.checkpoint_path, st.n, st.elem);
+                return false;
+            }
+        }
+    }
+    const unsigned long long resumed_shard = st.next_shard;
+    const unsigned long long resumed_rings = st.rings;
+    rcpa::install_stop_signals();
 
-    // --- Start Timing ---
     auto start_point = std::chrono::high_resolution_clock::now();
+    rcpa::DynamicGenerator<T> generator(current_n);
+    CheckpointChecksum<T> visit = { &st };
+    const bool done = rcpa::run_checkpointed(generator, visit, st, cfg.checkpoint_path, cfg.checkpoint_every);
+    auto end_point = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end_point - start_point;
+
+    if (!done) {
+        fprintf(stderr, "Stopped at shard %llu of %llu; checkpoint saved to %s, rerun with --resume.\n",
+                st.next_shard, st.shards, cfg.checkpoint_path);
+        return false;
+    }
 
-    // --- RCPA CORE LOGIC ---
-    int *P1 = D_PTR(curr_last, 0);
-    int *P2 = D_PTR(curr_last, current_n);
-    int *P3 = D_PTR(curr_last, current_n * 2 - 1);
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_algo");
+    printf("\nISA: %s", rcpa::isa_name(cfg.isa));
+    printf("\nN_VALUE: %d", current_n);
+    printf("\nELEMENT_TYPE: %s", elem_name);
+    printf("\nEXECUTION_TIME: %lf", diff.count());
+    printf("\nSPEED: %.2f", ((st.rings - resumed_rings) * current_n / diff.count()) / 1e9);
+    printf("\nRESUMED_FROM_SHARD: %llu", resumed_shard);
+    printf("\nSHARDS: %llu", st.shards);
+    printf("\nCHECKSUM: %llu", st.checksum);
+    printf("\nREPORT_END\n");
+    return true;
+}
 
-    const size_t memcpy_size = static_cast<size_t>(curr_2nd_last) * sizeof(int);
+// Exactly-once check of a full enumeration: every worker marks the N
+// permutations of each ring state in a shared N!-bit bitmap. Returns false
+// if any permutation is missing or repeated.
+template <typename T>
+bool run_rcpa_verified(const RunConfig& cfg, const char* elem_name) {
+    const int current_n = cfg.n;
 
-    for (int i = 0; i < current_n; i++) {
-        for (int j = 0; j < i; j++) {
-            *D_PTR(i, j) = j;
-            *D_PTR(i, j + i + 1) = j;
-        }
-        *D_PTR(i, i) = i;
+    auto start_point = std::chrono::high_resolution_clock::now();
+    rcpa::ShardedCoverage seen(current_n);
+    std::vector<rcpa::RingCoverage<T> > parts =
+        rcpa::parallel_for_each_ring_with<rcpa::DynamicGenerator<T> >(current_n, rcpa::RingCoverage<T>(&seen));
+    unsigned long long visited = 0, duplicates = 0;
+    for (size_t w = 0; w < parts.size(); w++) {
+        parts[w].finish();
+        visited += parts[w].visited;
+        duplicates += parts[w].duplicates;
     }
+    rcpa::CoverageResult r = seen.result(visited, duplicates);
+    auto end_point = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> diff = end_point - start_point;
 
-    int i_loop = curr_3rd_last - 1;
-    while (C[0] < 1) {
-        for (int j = i_loop + 1; j < curr_last; j++) {
-            const int* src_ptr = D_PTR(j - 1, C[j - 1]);
-            std::memcpy(D_PTR(j, 0), src_ptr, static_cast<size_t>(j) * sizeof(int));
-            std::memcpy(D_PTR(j, j + 1), src_ptr, static_cast<size_t>(j) * sizeof(int));
-        }
+    int perm[rcpa::COVERAGE_MAX_N];
+    for (size_t k = 0; k < r.first_missing.size(); k++) {
+        rcpa::rotation_unindex(r.first_missing[k], current_n, perm);
+        printf("MISSING:");
+        for (int t = 0; t < current_n; t++) printf(" %d", perm[t]);
+        printf("\n");
+    }
 
-        const int *src_ptr = D_PTR(curr_3rd_last, C[curr_3rd_last]);
-        std::memcpy(P1, src_ptr, memcpy_size);
-        *(P1 + curr_2nd_last) = curr_2nd_last;
-        *(P1 + curr_last) = curr_last;
-        std::memcpy(P2, src_ptr, memcpy_size);
-        *(P2 + curr_2nd_last) = curr_2nd_last;
-        std::memcpy(P3, src_ptr, memcpy_size);
-
-        for (int circle_index = 0; circle_index < curr_last; circle_index++) {
-            // Output for validation
-            if (current_n <= LITTLE_NUMBER) {
-                for (int circlehead = circle_index; circlehead < circle_index + current_n; circlehead++) {
-                    for (int oneperm = circlehead; oneperm < circlehead + current_n; oneperm++) {
-                        printf("%d ", *D_PTR(curr_last, oneperm));
-                    }
-                    printf("\n");
-                }
-            }
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_algo");
+    printf("\nISA: %s", rcpa::isa_name(cfg.isa));
+    printf("\nN_VALUE: %d", current_n);
+    printf("\nELEMENT_TYPE: %s", elem_name);
+    printf("\nTHREADS: %u", static_cast<unsigned>(parts.size()));
+    printf("\nEXECUTION_TIME: %lf", diff.count());
+    printf("\nSPEED: %.2f", (visited / diff.count()) / 1e9);
+    printf("\nVISITED: %llu", r.visited);
+    printf("\nCOVERED: %llu", r.covered);
+    printf("\nMISSING: %llu", r.missing);
+    printf("\nDUPLICATES: %llu", r.duplicates);
+    printf("\nVERIFY: %s", r.pass() ? "PASS" : "FAIL");
+    printf("\nREPORT_END\n");
+    return r.pass();
+}
 
-            *D_PTR(curr_last, curr_last + circle_index) = *D_PTR(curr_last, current_n + circle_index);
-            *D_PTR(curr_last, current_n + circle_index) = curr_last;
-        }
+template <typename T>
+void run_rcpa(const RunConfig& cfg, const char* elem_name) {
+    const int current_n = cfg.n;
+    const int curr_last = current_n - 1;
 
-        C[curr_3rd_last]++;
-        for (i_loop = curr_3rd_last; (i_loop > 0) && (C[i_loop] > i_loop); i_loop--) {
-            C[i_loop] = 0;
-            C[i_loop - 1]++;
-        }
+    // --- Start Timing ---
+    auto start_point = std::chrono::high_resolution_clock::now();
+
+    // --- RCPA CORE LOGIC (rcpa.hpp) ---
+    rcpa::DynamicGenerator<T> generator(current_n);
+    unsigned long long checksum = 0;
+    std::unique_ptr<rcpa::TextWriter> text;
+    if (cfg.text_sep != 0 || current_n <= LITTLE_NUMBER) {
+        text.reset(new rcpa::TextWriter(current_n, cfg.text_sep != 0 ? cfg.text_sep : ' '));
+    }
+    rcpa::reset_op_counts();
+    rcpa::PerfCounters perf;
+    if (cfg.perf) {
+        perf.open();
+        perf.start();
+    }
+
+    if (cfg.use_range) {
+        generator.run_range(cfg.range_begin, cfg.range_end, [&](const T* perm) {
+            for (int k = 0; k < current_n; k++) checksum += static_cast<unsigned long long>(k * perm[k]);
+            if (text) text->line(perm);
+        });
+    } else if (text) {
+        // Output for validation
+        generator.for_each([&](const T* perm) { text->line(perm); });
+    } else {
+        generator.for_each_ring([](const T*) {});
     }
+    if (text) text->flush();
+    if (cfg.perf) perf.stop();
 
     // --- End Timing ---
     auto end_point = std::chrono::high_resolution_clock::now();
@@ -118,12 +227,160 @@ int main(int argc, char* argv[]) {
     // --- Standardized Report Output ---
     printf("\nREPORT_START");
     printf("\nALGORITHM: rcpa_algo");
+    printf("\nISA: %s", rcpa::isa_name(cfg.isa));
     printf("\nN_VALUE: %d", current_n);
+    printf("\nELEMENT_TYPE: %s", elem_name);
     printf("\nEXECUTION_TIME: %lf", diff.count());
+    if (cfg.use_range) {
+        printf("\nRANGE_BEGIN: %llu", cfg.range_begin);
+        printf("\nRANGE_END: %llu", cfg.range_end);
+        printf("\nCHECKSUM: %llu", checksum);
+    } else {
+        printf("\nSPEED: %.2f", (rcpa::factorial(current_n) / diff.count()) / 1e9);
+    }
+    if (cfg.perf) {
+        const unsigned long long perms = cfg.use_range ? cfg.range_end - cfg.range_begin : rcpa::factorial(current_n);
+        const unsigned long long block = static_cast<unsigned long long>(current_n) * (current_n - 1);
+        rcpa::write_perf_report(stdout, perf, perms, (perms + block - 1) / block);
+    }
+    if (rcpa::OPCOUNT_ENABLED) rcpa::write_opcount_report(stdout, rcpa::op_counts());
     printf("\nREPORT_END\n");
-    
-    std::free(C);
-    std::free(D_flat);
 
+    // Minimal-cost Anti-optimization Barrier
+    const T volatile* anti_opt = generator.row(curr_last);
+    if (*anti_opt == static_cast<T>(-1)) printf("rare\n");
+}
+
+// run_rcpa compiled for one ISA variant (see rcpa::dispatch)
+template <typename T>
+struct RcpaKernel {
+    const RunConfig* cfg;
+    const char* elem_name;
+    bool done;
+
+    template <class Tag>
+    void operator()(Tag) {
+        if (cfg->verify) done = run_rcpa_verified<T>(*cfg, elem_name);
+        else if (cfg->checkpoint_path != NULL) done = run_rcpa_checkpointed<T>(*cfg, elem_name);
+        else run_rcpa<T>(*cfg, elem_name);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const char* elem = "int";
+    const char* isa_flag = NULL;
+    const char* checkpoint_path = NULL;
+    unsigned long long checkpoint_every = 1ull << 24;
+    bool resume = false;
+    char text_sep = 0;
+    bool verify = false;
+    bool perf = false;
+    const char* positional[3] = { NULL, NULL, NULL };
+    int n_positional = 0;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--elem=", 7) == 0) {
+            elem = argv[a] + 7;
+        } else if (std::strncmp(argv[a], "--isa=", 6) == 0) {
+            isa_flag = argv[a] + 6;
+        } else if (std::strncmp(argv[a], "--checkpoint=", 13) == 0) {
+            checkpoint_path = argv[a] + 13;
+        } else if (std::strncmp(argv[a], "--every=", 8) == 0) {
+            checkpoint_every = std::strtoull(argv[a] + 8, NULL, 10);
+        } else if (std::strcmp(argv[a], "--resume") == 0) {
+            resume = true;
+        } else if (std::strcmp(argv[a], "--text") == 0) {
+            text_sep = ' ';
+        } else if (std::strcmp(argv[a], "--verify") == 0) {
+            verify = true;
+        } else if (std::strcmp(argv[a], "--perf") == 0) {
+            perf = true;
+        } else if (std::strncmp(argv[a], "--text=", 7) == 0) {
+            if (!rcpa::parse_text_separator(argv[a] + 7, text_sep)) {
+                fprintf(stderr, "Error: unknown text separator '%s' (space|comma).\n", argv[a] + 7);
+                return 1;
+            }
+        } else if (n_positional < 3) {
+            positional[n_positional++] = argv[a];
+        }
+    }
+    if (n_positional != 1 && n_positional != 3) {
+        fprintf(stderr, "Usage: %s <n> [begin end] [--elem=int|u16|u8|all] [--isa=NAME]"
+                        " [--checkpoint=FILE [--every=BLOCKS] [--resume]] [--text[=space|comma]]"
+                        " [--verify] [--perf]\n", argv[0]);
+        return 1;
+    }
+    int n_val = std::atoi(positional[0]);
+    if (n_val <= 3) {
+        fprintf(stderr, "Error: n must be greater than 3 for RCPA logic.\n");
+        return 1;
+    }
+
+    RunConfig cfg;
+    cfg.n = n_val;
+    // Optional RCPA index range [begin, end) for multi-process splits
+    cfg.use_range = (n_positional == 3);
+    cfg.range_begin = cfg.use_range ? std::strtoull(positional[1], NULL, 10) : 0;
+    cfg.range_end = cfg.use_range ? std::strtoull(positional[2], NULL, 10) : 0;
+    cfg.checkpoint_path = checkpoint_path;
+    cfg.checkpoint_every = checkpoint_every ? checkpoint_every : 1;
+    cfg.resume = resume;
+    cfg.text_sep = text_sep;
+    cfg.verify = verify;
+    cfg.perf = perf;
+    if (!rcpa::resolve_isa(isa_flag, cfg.isa)) return 1;
+
+    const bool all = (std::strcmp(elem, "all") == 0);
+    const bool want_int = all || std::strcmp(elem, "int") == 0;
+    const bool want_u16 = all || std::strcmp(elem, "u16") == 0;
+    const bool want_u8 = all || std::strcmp(elem, "u8") == 0;
+    if (!want_int && !want_u16 && !want_u8) {
+        fprintf(stderr, "Error: unknown element type '%s'.\n", elem);
+        return 1;
+    }
+    if (checkpoint_path != NULL && (all || cfg.use_range)) {
+        fprintf(stderr, "Error: --checkpoint needs a full run of a single element type.\n");
+        return 1;
+    }
+    if (checkpoint_path != NULL && text_sep != 0) {
+        fprintf(stderr, "Error: --text cannot be combined with --checkpoint.\n");
+        return 1;
+    }
+    if (perf && (verify || checkpoint_path != NULL)) {
+        fprintf(stderr, "Error: --perf measures the plain run, not --verify or --checkpoint.\n");
+        return 1;
+    }
+    if (verify && (checkpoint_path != NULL || cfg.use_range || text_sep != 0)) {
+        fprintf(stderr, "Error: --verify needs a full run without --checkpoint or --text.\n");
+        return 1;
+    }
+    if (verify && n_val > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports n <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    if (resume && checkpoint_path == NULL) {
+        fprintf(stderr, "Error: --resume needs --checkpoint=FILE.\n");
+        return 1;
+    }
+
+    // --- Set CPU Affinity (Consistent with A-Suite) ---
+#ifdef _WIN32
+    DWORD_PTR mask = 8; // Core 3
+    SetThreadAffinityMask(GetCurrentThread(), mask);
+#else
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(1, &cpuset); // Core 1
+    sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+#endif
+
+    RcpaKernel<int> kernel_int = { &cfg, "int", true };
+    RcpaKernel<uint16_t> kernel_u16 = { &cfg, "uint16_t", true };
+    RcpaKernel<uint8_t> kernel_u8 = { &cfg, "uint8_t", true };
+    if (want_int) rcpa::dispatch(cfg.isa, kernel_int);
+    if (want_u16) rcpa::dispatch(cfg.isa, kernel_u16);
+    if (want_u8) rcpa::dispatch(cfg.isa, kernel_u8);
+
+    if (!kernel_int.done || !kernel_u16.done || !kernel_u8.done) return rcpa::stop_requested() ? EXIT_RESUMABLE : 1;
     return 0;
 }
@@ -1,10 +1,23 @@
 /**
  * @file heap_perm.cpp
  * @brief Heap's Permutation Generation Algorithm (Dynamic Size via CLI)
+ * Usage: ./heap_test <n> [--text[=space|comma]] [--verify]
+ *   --text   : print every permutation, one per line, for any n (default only
+ *              for n <= LITTLE_NUMBER, comma-separated) through rcpa_text.hpp
+ *   --verify : check that every permutation is generated exactly once
+ *              (rcpa_coverage.hpp); exit status 1 otherwise
+ * Built with -DRCPA_OPCOUNT the report adds swaps, carries (c[i] reset to 0)
+ * and permutations emitted (rcpa_opcount.hpp).
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <chrono>
+#include <memory>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_opcount.hpp"
+#include "rcpa_text.hpp"
 
 #ifdef _WIN32
     #include <windows.h>
@@ -18,7 +31,7 @@ const int LITTLE_NUMBER = 5;
 int main(int argc, char* argv[]) {
     // --- Parse Command Line Argument ---
     if (argc < 2) {
-        fprintf(stderr, "Usage: %s <n>\n", argv[0]);
+        fprintf(stderr, "Usage: %s <n> [--text[=space|comma]] [--verify]\n", argv[0]);
         return 1;
     }
     int perm_size = atoi(argv[1]);
@@ -26,6 +39,22 @@ int main(int argc, char* argv[]) {
         fprintf(stderr, "Error: n must be a positive integer.\n");
         return 1;
     }
+    char text_sep = 0;
+    bool verify = false;
+    for (int a = 2; a < argc; a++) {
+        if (strcmp(argv[a], "--text") == 0) {
+            text_sep = ',';
+        } else if (strcmp(argv[a], "--verify") == 0) {
+            verify = true;
+        } else if (strncmp(argv[a], "--text=", 7) == 0 && !rcpa::parse_text_separator(argv[a] + 7, text_sep)) {
+            fprintf(stderr, "Error: unknown text separator '%s' (space|comma).\n", argv[a] + 7);
+            return 1;
+        }
+    }
+    if (verify && (perm_size < 2 || perm_size > rcpa::COVERAGE_MAX_N)) {
+        fprintf(stderr, "Error: --verify supports 2 <= n <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
 
     // --- Set CPU Affinity ---
     #ifdef _WIN32
@@ -50,15 +79,26 @@ int main(int argc, char* argv[]) {
         c[i] = 0;
     }
 
+    // Optional text output (digit tables + writev instead of printf)
+    std::unique_ptr<rcpa::TextWriter> text;
+    if (text_sep != 0 || perm_size <= LITTLE_NUMBER) {
+        text.reset(new rcpa::TextWriter(perm_size, text_sep != 0 ? text_sep : ','));
+    }
+
+    // Optional exactly-once check: one bitmap bit per permutation
+    std::unique_ptr<rcpa::ShardedCoverage> seen;
+    if (verify) seen.reset(new rcpa::ShardedCoverage(perm_size));
+    rcpa::PermCoverage<int> cover(seen.get());
+
     // --- Start Timing ---
+    rcpa::reset_op_counts();
     auto start = std::chrono::high_resolution_clock::now();
 
     // Initial permutation checksum and optional print
-    if (perm_size <= LITTLE_NUMBER) {
-        printf("\n");
-        for (j = 0; j < perm_size; j++) printf("%d,", D[j]);
-    }
+    if (text) text->line(D);
+    if (verify) cover(D);
     for (i = 0; i < perm_size; i++) checksum += D[i];
+    RCPA_COUNT_OP(perms, 1);
 
     // Heap's algorithm core logic
     i = 1;
@@ -69,12 +109,12 @@ int main(int argc, char* argv[]) {
             } else {
                 int temp = D[c[i]]; D[c[i]] = D[i]; D[i] = temp;
             }
+            RCPA_COUNT_OP(swaps, 1);
+            RCPA_COUNT_OP(perms, 1);
 
-            // High-performance check: only print if n is small
-            if (perm_size <= LITTLE_NUMBER) {
-                printf("\n");
-                for (j = 0; j < perm_size; j++) printf("%d,", D[j]);
-            }
+            // High-performance check: only print if requested or n is small
+            if (text) text->line(D);
+            if (verify) cover(D);
             
             // This loop remains for checksum calculation
             for (j = 0; j < perm_size; j++) checksum += j * D[j]; // Modified slightly for better validation
@@ -82,11 +122,14 @@ int main(int argc, char* argv[]) {
             c[i]++;
             i = 1;
         } else {
+            RCPA_COUNT_CARRY(i);
             c[i] = 0;
             i++;
         }
     }
 
+    if (text) text->flush();
+
     // --- End Timing ---
     auto finish = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = finish - start;
@@ -97,10 +140,20 @@ int main(int argc, char* argv[]) {
     printf("\nN_VALUE: %d", perm_size);
     printf("\nEXECUTION_TIME: %lf", duration.count());
     printf("\nCHECKSUM: %llu", checksum);
+    if (rcpa::OPCOUNT_ENABLED) rcpa::write_opcount_report(stdout, rcpa::op_counts());
+    bool passed = true;
+    if (verify) {
+        rcpa::CoverageResult r = seen->result(cover.visited, cover.duplicates);
+        passed = r.pass();
+        printf("\nVISITED: %llu", r.visited);
+        printf("\nMISSING: %llu", r.missing);
+        printf("\nDUPLICATES: %llu", r.duplicates);
+        printf("\nVERIFY: %s", passed ? "PASS" : "FAIL");
+    }
     printf("\nREPORT_END\n");
 
     free(D);
     free(c);
 
-    return 0;
+    return passed ? 0 : 1;
 }
@@ -10,13 +10,31 @@
  * - Performance: Designed for minimal branch misprediction and low overhead.
  * * Environment:
  * - Platform: Windows / Linux (Auto-switching headers)
- * - Compiler: GCC/MinGW (supports __builtin_LINE) or MSVC
+ * - Compiler: GCC/MinGW or MSVC
+ * * Usage: ./pp_test <n> [--elem=int|u16|u8|all] [--isa=NAME] [--text[=space|comma]] [--verify] [--perf]
+ * - --text prints every permutation, one per line, for any n (default only for
+ *   n <= LITTLE_NUMBER, comma-separated) through rcpa_text.hpp.
+ * - --verify checks that every permutation is generated exactly once
+ *   (rcpa_coverage.hpp) and exits with status 1 otherwise.
+ * - --perf reports hardware counters per permutation and per outer loop
+ *   iteration (rcpa_perf.hpp).
+ * - Built with -DRCPA_OPCOUNT the report adds swaps, carries and
+ *   permutations emitted (rcpa_opcount.hpp).
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
 #include <chrono>
+#include <memory>
 #include <vector>
 
+#include "rcpa_coverage.hpp"
+#include "rcpa_dispatch.hpp"
+#include "rcpa_opcount.hpp"
+#include "rcpa_perf.hpp"
+#include "rcpa_text.hpp"
+
 #ifdef _WIN32
     #include <windows.h>
 #else
@@ -26,99 +44,185 @@
 
 const int LITTLE_NUMBER = 5;
 
-// #define DEBUG
-
-#ifdef DEBUG
-#define COUNT_PURECESS() ProcessCount[__builtin_LINE()]++
-#else
-#define COUNT_PURECESS() 
-#endif
-
-int main(int argc, char* argv[]) {
-    // --- Parse Command Line Argument ---
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <n>\n", argv[0]);
-        return 1;
-    }
-    int perm_size = atoi(argv[1]);
-    if (perm_size <= 1) {
-        fprintf(stderr, "Error: n must be greater than 1.\n");
-        return 1;
-    }
-
-    // --- Set CPU Affinity for Accurate Benchmarking ---
-#ifdef _WIN32
-    DWORD_PTR mask = 8; // CPU mask for core 3
-    SetThreadAffinityMask(GetCurrentThread(), mask);
-#else
-    cpu_set_t cpuset;
-    CPU_ZERO(&cpuset);
-    CPU_SET(1, &cpuset);
-    sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
-#endif
-
+// Runs the PP algorithm over all perm_size! permutations with element type T
+// for the D array and prints the standardized report. Returns false if
+// `verify` found a missing or repeated permutation.
+template <typename T>
+bool run_permpure(int perm_size, const char* elem_name, rcpa::Isa isa, char text_sep, bool verify, bool perf) {
     unsigned long long checksum = 0;
-    unsigned long long ProcessCount[200] = {0};
     int i = 0;
     
     // Use std::vector for dynamic memory management
     std::vector<int> C(perm_size, 0);
-    std::vector<int> D(perm_size, 0);
+    std::vector<T> D(perm_size, 0);
     // M array was initialized but not heavily used in the provided snippet, 
     // keeping it for consistency if needed.
     std::vector<int> M(perm_size, 0); 
 
+    // Optional text output (digit tables + writev instead of printf)
+    std::unique_ptr<rcpa::TextWriter> text;
+    if (text_sep != 0 || perm_size <= LITTLE_NUMBER) {
+        text.reset(new rcpa::TextWriter(perm_size, text_sep != 0 ? text_sep : ','));
+    }
+
+    // Optional exactly-once check: one bitmap bit per permutation
+    std::unique_ptr<rcpa::ShardedCoverage> seen;
+    if (verify) seen.reset(new rcpa::ShardedCoverage(perm_size));
+    rcpa::PermCoverage<T> cover(seen.get());
+
+    // Optional hardware counters around the main loop
+    rcpa::PerfCounters counters;
+    if (perf) counters.open();
+    rcpa::reset_op_counts();
+
     // --- High Precision Timing ---
     auto start = std::chrono::high_resolution_clock::now();
+    if (perf) counters.start();
 
     // Main Algorithm Loop (PP Algorithm)
     while (C[0] < 1) {
-        COUNT_PURECESS();
+        RCPA_COUNT_OP(swaps, perm_size - 1 - i);
         for (; i < perm_size - 1; ++i) {
-            COUNT_PURECESS();
             D[i] = D[C[i]];
-            D[C[i]] = i;
+            D[C[i]] = static_cast<T>(i);
         }
 
         for (int ii = 0; ii < perm_size; ii++) {
-            COUNT_PURECESS();
             D[perm_size - 1] = D[ii];
-            D[ii] = perm_size - 1;
+            D[ii] = static_cast<T>(perm_size - 1);
             
             // Standardizing checksum to match the core logic
             checksum += D[perm_size - 1];
 
-            // Reduced I/O overhead using LITTLE_NUMBER check
-            if (perm_size <= LITTLE_NUMBER) {
-                printf("\n");
-                for (int jj = 0; jj < perm_size; jj++) {
-                    printf("%d,", D[jj]);
-                }
-            }
+            // Reduced I/O overhead: only print if requested or n is small
+            if (text) text->line(D.data());
+            if (verify) cover(D.data());
             D[ii] = D[perm_size - 1];
         }
+        RCPA_COUNT_OP(swaps, perm_size + 1);
+        RCPA_COUNT_OP(perms, perm_size);
 
         D[C[perm_size - 2]] = D[perm_size - 2];
 
         C[perm_size - 2]++;
         for (i = perm_size - 2; (i > 0) && (C[i] > i); i--) {
-            COUNT_PURECESS();
+            RCPA_COUNT_CARRY(i);
+            RCPA_COUNT_OP(swaps, 1);
             C[i] = 0;
             C[i - 1]++;
             D[C[i - 1] - 1] = D[i - 1];
         }
     }
 
+    if (text) text->flush();
+    if (perf) counters.stop();
+
     auto finish = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> duration = finish - start;
     
+    unsigned long long total_perms = 1;
+    for (int k = 2; k <= perm_size; k++) total_perms *= k;
+
     // Standardized output for easy parsing
     printf("\nREPORT_START");
     printf("\nALGORITHM: permpure_full");
+    printf("\nISA: %s", rcpa::isa_name(isa));
     printf("\nN_VALUE: %d", perm_size);
+    printf("\nELEMENT_TYPE: %s", elem_name);
     printf("\nEXECUTION_TIME: %lf", duration.count());
+    printf("\nSPEED: %.2f", (total_perms / duration.count()) / 1e9);
     printf("\nCHECKSUM: %llu", checksum);
+    // One outer iteration emits perm_size permutations.
+    if (perf) rcpa::write_perf_report(stdout, counters, total_perms, total_perms / perm_size);
+    if (rcpa::OPCOUNT_ENABLED) rcpa::write_opcount_report(stdout, rcpa::op_counts());
+    bool passed = true;
+    if (verify) {
+        rcpa::CoverageResult r = seen->result(cover.visited, cover.duplicates);
+        passed = r.pass();
+        printf("\nVISITED: %llu", r.visited);
+        printf("\nMISSING: %llu", r.missing);
+        printf("\nDUPLICATES: %llu", r.duplicates);
+        printf("\nVERIFY: %s", passed ? "PASS" : "FAIL");
+    }
     printf("\nREPORT_END\n");
+    return passed;
+}
+
+// run_permpure compiled for one ISA variant (see rcpa::dispatch)
+template <typename T>
+struct PermpureKernel {
+    int perm_size;
+    const char* elem_name;
+    rcpa::Isa isa;
+    char text_sep;
+    bool verify;
+    bool perf;
+    bool passed;
+
+    template <class Tag>
+    void operator()(Tag) { passed = run_permpure<T>(perm_size, elem_name, isa, text_sep, verify, perf); }
+};
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <n> [--elem=int|u16|u8|all] [--isa=scalar|sse4.2|avx2|avx512]"
+                        " [--text[=space|comma]] [--verify] [--perf]\n", argv[0]);
+        return 1;
+    }
+    int perm_size = atoi(argv[1]);
+    if (perm_size <= 1) {
+        fprintf(stderr, "Error: n must be greater than 1.\n");
+        return 1;
+    }
+    const char* elem = "int";
+    const char* isa_flag = NULL;
+    char text_sep = 0;
+    bool verify = false;
+    bool perf = false;
+    for (int a = 2; a < argc; a++) {
+        if (strncmp(argv[a], "--elem=", 7) == 0) elem = argv[a] + 7;
+        else if (strncmp(argv[a], "--isa=", 6) == 0) isa_flag = argv[a] + 6;
+        else if (strcmp(argv[a], "--text") == 0) text_sep = ',';
+        else if (strcmp(argv[a], "--verify") == 0) verify = true;
+        else if (strcmp(argv[a], "--perf") == 0) perf = true;
+        else if (strncmp(argv[a], "--text=", 7) == 0 && !rcpa::parse_text_separator(argv[a] + 7, text_sep)) {
+            fprintf(stderr, "Error: unknown text separator '%s' (space|comma).\n", argv[a] + 7);
+            return 1;
+        }
+    }
+    const bool all = (strcmp(elem, "all") == 0);
+    const bool want_int = all || strcmp(elem, "int") == 0;
+    const bool want_u16 = all || strcmp(elem, "u16") == 0;
+    const bool want_u8 = all || strcmp(elem, "u8") == 0;
+    if (!want_int && !want_u16 && !want_u8) {
+        fprintf(stderr, "Error: unknown element type '%s'.\n", elem);
+        return 1;
+    }
+    if (verify && perm_size > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports n <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    rcpa::Isa isa;
+    if (!rcpa::resolve_isa(isa_flag, isa)) return 1;
+
+    // --- Set CPU Affinity for Accurate Benchmarking ---
+#ifdef _WIN32
+    DWORD_PTR mask = 8; // CPU mask for core 3
+    SetThreadAffinityMask(GetCurrentThread(), mask);
+#else
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(1, &cpuset);
+    sched_setaffinity(0, sizeof(cpu_set_t), &cpuset);
+#endif
+
+    PermpureKernel<int> kernel_int = { perm_size, "int", isa, text_sep, verify, perf, true };
+    PermpureKernel<uint16_t> kernel_u16 = { perm_size, "uint16_t", isa, text_sep, verify, perf, true };
+    PermpureKernel<uint8_t> kernel_u8 = { perm_size, "uint8_t", isa, text_sep, verify, perf, true };
+    if (want_int) rcpa::dispatch(isa, kernel_int);
+    if (want_u16) rcpa::dispatch(isa, kernel_u16);
+    if (want_u8) rcpa::dispatch(isa, kernel_u8);
 
 #ifdef DEBUG
     // Debug info logic preserved for N
@@ -137,6 +241,6 @@ int main(int argc, char* argv[]) {
     }
 #endif
 
-    return 0;
+    return (kernel_int.passed && kernel_u16.passed && kernel_u8.passed) ? 0 : 1;
 
 }
@@ -0,0 +1,155 @@
+/**
+ * @file    ppa_rcpa_simd.cpp
+ * @brief   PP + ring burst kernel comparison: scalar vs AVX2 vs AVX-512
+ * @author  YUSHENG-HU
+ * @details
+ * Runs the PP + ring generator (rcpa_pp.hpp) with every burst kernel the
+ * build enables and two consumers per kernel:
+ *   - checksum : inlined visitor reading ring[0] and ring[N-1]; matching
+ *                checksums confirm the kernels agree. The scalar swap chain
+ *                can be folded into registers here.
+ *   - opaque   : visitor the compiler cannot see through, so every ring state
+ *                must be complete in memory (the case of real consumers).
+ *
+ * The SIMD kernels are picked at runtime (rcpa_dispatch.hpp): every burst up
+ * to the selected ISA variant is run, so no -march flag is needed.
+ *
+ * With --verify every kernel also passes its ring states through the
+ * exactly-once coverage check of rcpa_coverage.hpp (untimed; CP_N <= 14).
+ *
+ * Build: g++ -O3 -std=c++17 -DPP_N=11 cpp/ppa_rcpa_simd.cpp -o ppa_simd -pthread
+ * Usage: ./ppa_simd [--isa=scalar|sse4.2|avx2|avx512] [--verify]
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <type_traits>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_pp.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+#ifndef PP_N
+#define PP_N 11 // Default setup for N=13 (CP_N = PP_N + 2)
+#endif
+
+const int CP_N = PP_N + 2;
+
+// Function to bind execution to a specific CPU core
+void bind_to_core(int core_id) {
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), 1ull << core_id);
+#else
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#endif
+}
+
+// Returns false if `verify` found a missing or repeated permutation.
+template <typename T, class Burst>
+bool run_kernel(const char* elem_name, bool verify) {
+    rcpa::PPRingGenerator<CP_N, T, Burst> generator;
+    unsigned long long checksum = 0;
+    const unsigned long long total_perms = rcpa::factorial(CP_N);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring([&](const T* ring) {
+        checksum += static_cast<unsigned long long>(ring[0]) * CP_N + ring[CP_N - 1];
+    });
+    auto finish = std::chrono::high_resolution_clock::now();
+    double checksum_time = std::chrono::duration<double>(finish - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring([](const T* ring) {
+        __asm__ __volatile__("" : : "r"(ring) : "memory");
+    });
+    finish = std::chrono::high_resolution_clock::now();
+    double opaque_time = std::chrono::duration<double>(finish - start).count();
+
+    // Standardized output for log parsing
+    printf("Kernel: %s (%s)\n", Burst::name(), elem_name);
+    printf("N: %d\n", CP_N);
+    printf("Total Permutations: %llu\n", total_perms);
+    printf("Time: %.6f\n", checksum_time);
+    printf("Speed: %.2f\n", (total_perms / checksum_time) / 1e9);
+    printf("Opaque Time: %.6f\n", opaque_time);
+    printf("Opaque Speed: %.2f\n", (total_perms / opaque_time) / 1e9);
+
+    // Optional exactly-once check, outside the timed passes
+    bool passed = true;
+    if (verify) {
+        rcpa::ShardedCoverage seen(CP_N);
+        rcpa::RingCoverage<T> cover(&seen);
+        generator.for_each_ring(cover);
+        cover.finish();
+        rcpa::CoverageResult r = seen.result(cover.visited, cover.duplicates);
+        passed = r.pass();
+        printf("Verify: %s (missing %llu, duplicates %llu)\n", passed ? "PASS" : "FAIL", r.missing, r.duplicates);
+    }
+    printf("Checksum: %llu\n\n", checksum);
+    return passed;
+}
+
+// Runs run_kernel inside an ISA variant: with the scalar burst, or with the
+// burst of the variant itself (rcpa::BurstFor).
+template <typename T, bool SIMD>
+struct KernelRun {
+    const char* elem_name;
+    bool verify;
+    bool passed;
+
+    template <class Tag>
+    void operator()(Tag) {
+        typedef typename rcpa::BurstFor<Tag::value>::type SimdBurst;
+        typedef typename std::conditional<SIMD, SimdBurst, rcpa::BurstScalar>::type Burst;
+        if (!run_kernel<T, Burst>(elem_name, verify)) passed = false;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const char* isa_flag = NULL;
+    bool verify = false;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--isa=", 6) == 0) {
+            isa_flag = argv[a] + 6;
+        } else if (std::strcmp(argv[a], "--verify") == 0) {
+            verify = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--isa=scalar|sse4.2|avx2|avx512] [--verify]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (verify && CP_N > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports N <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    rcpa::Isa isa;
+    if (!rcpa::resolve_isa(isa_flag, isa)) return 1;
+
+    bind_to_core(0);
+    printf("ISA: %s\n\n", rcpa::isa_name(isa));
+
+    KernelRun<int, false> scalar_int = { "int", verify, true };
+    KernelRun<uint8_t, false> scalar_u8 = { "uint8_t", verify, true };
+    KernelRun<uint8_t, true> simd_u8 = { "uint8_t", verify, true };
+    rcpa::dispatch(isa, scalar_int);
+    rcpa::dispatch(isa, scalar_u8);
+    if (isa >= rcpa::Isa::Avx2 && rcpa::BurstAvx2::supports<CP_N, uint8_t>())
+        rcpa::dispatch(rcpa::Isa::Avx2, simd_u8);
+    if (isa >= rcpa::Isa::Avx512 && rcpa::BurstAvx512::supports<CP_N, uint8_t>())
+        rcpa::dispatch(rcpa::Isa::Avx512, simd_u8);
+
+    return (scalar_int.passed && scalar_u8.passed && simd_u8.passed) ? 0 : 1;
+}
@@ -14,6 +14,12 @@
  * mirrored P2/P3 segments via memcpy for O(1) sliding window access.
  * 3. Incremental PP: Generates (N-2)! base states in-place on P1, 
  * ensuring cache-local operations and minimal branch mispredictions.
+ * The generator is rcpa::PPRingGenerator (rcpa_pp.hpp) with the scalar burst;
+ * this file times bare generation per element type, ISA variant and N: the
+ * ring states are produced but not read, and only the last one is touched
+ * after the clock stops. ppa_rcpa.cpp adds a checksum over every ring state.
+ * Built with -DRCPA_OPCOUNT it also prints the operation counts per
+ * permutation (rcpa_opcount.hpp).
  * * License: MIT License
  * Copyright (c) 2026 YUSHENG-HU
  */
@@ -23,6 +29,10 @@
  #include <cstring>
  #include <chrono>
  #include <cstdio>
+ #include <cstdlib>
+ #include <cstdint>
+ 
+ #include "rcpa_pp.hpp"
  
  // System headers for CPU affinity
  #ifdef _WIN32
@@ -33,9 +43,14 @@
  #endif
  
  #ifndef PP_N
- #define PP_N 13 // Default setup for N=15 (CP_N = PP_N + 2)
+ #define PP_N 13 // Default setup for N=15 (CP_N = PP_N + 2); --n=N picks another N at runtime
  #endif
  
+ // Range of N compiled into the binary: one kernel per N, unrolled with
+ // constant offsets, selected at runtime through rcpa::dispatch_size().
+ const int MIN_CP_N = 4;
+ const int MAX_CP_N = 20;
+ 
  // Function to bind execution to a specific CPU core
  void bind_to_core(int core_id) {
  #ifdef _WIN32
@@ -58,75 +73,104 @@
      return res;
  }
  
- int main() {
-     // Core binding should be performed before main logic execution
-     bind_to_core(0);
- 
-     const int CP_N = PP_N + 2; 
-     const int VAL_ELM_N_MINUS_2 = PP_N;      
-     const int VAL_ELM_N_MINUS_1 = PP_N + 1;  
- 
-     const int OFFSET_B1 = 0;
-     const int OFFSET_B2 = CP_N;
-     const int OFFSET_B3 = CP_N + (CP_N - 1);
- 
-     alignas(64) static int D[3 * CP_N] = {0}; 
-     int C[PP_N] = {0};
-     int i = 0;
- 
-     for (int k = 0; k < PP_N; k++) D[k] = k;
+ // Runs the PP + ring generator (rcpa_pp.hpp, scalar burst) over all CP_N!
+ // permutations with element type T for the D buffer; returns the elapsed
+ // time in seconds.
+ template <typename T, int CP_N>
+ double run_ppa_rcpa() {
+     rcpa::PPRingGenerator<CP_N, T, rcpa::BurstScalar> generator;
+     const T* last = NULL;
  
      auto start = std::chrono::high_resolution_clock::now();
- 
-     // Main Permutation Generation Loop
-     while (C[0] < 1) {
-         for (; i < PP_N - 1; ++i) {
-             D[i] = D[C[i]];
-             D[C[i]] = i;
-         }
- 
-         for (int ii = 0; ii < PP_N; ii++) {
-             D[PP_N - 1] = D[ii];
-             D[ii] = PP_N - 1;
-             D[PP_N] = VAL_ELM_N_MINUS_2;
-             D[PP_N + 1] = VAL_ELM_N_MINUS_1;
-             
-             __builtin_memcpy(&D[OFFSET_B2], &D[OFFSET_B1], (CP_N - 1) * sizeof(int));
-             __builtin_memcpy(&D[OFFSET_B3], &D[OFFSET_B1], (CP_N - 1) * sizeof(int));
- 
-             // Pointer pre-calculation for single-core addressing speed
-             int* target = &D[PP_N + 1];
-             #pragma GCC unroll 16
-             for (int layer_shift = 0; layer_shift < CP_N - 1; layer_shift++) {
-                 int temp = *(target + 1);
-                 *(target + 1) = *target;
-                 *target = temp;
-                 target++;
-             }
-             D[ii] = D[PP_N - 1];
-         }
- 
-         D[C[PP_N - 2]] = D[PP_N - 2];
-         C[PP_N - 2]++;
-         for (i = PP_N - 2; (i > 0) && (C[i] > i); i--) {
-             C[i] = 0;
-             C[i - 1]++;
-             D[C[i - 1] - 1] = D[i - 1];
-         }
-     }
- 
+     generator.for_each_ring([&last](const T* ring) { last = ring; });
      auto finish = std::chrono::high_resolution_clock::now();
      double duration = std::chrono::duration<double>(finish - start).count();
  
+     const T volatile* anti_opt = &last[CP_N - 1];
+     if (*anti_opt == static_cast<T>(-1)) printf("rare\n");
+     return duration;
+ }
+ 
+ template <typename T, int CP_N>
+ void report(const char* elem_name, rcpa::Isa isa) {
+     rcpa::reset_op_counts();
+     double duration = run_ppa_rcpa<T, CP_N>();
      unsigned long long total_perms = get_factorial(CP_N);
-     int volatile* anti_opt = &D[CP_N - 1];
-     if (*anti_opt == -999) printf("rare\n");
  
      // Standardized output for log parsing
+     printf("ISA: %s\n", rcpa::isa_name(isa));
+     printf("Element Type: %s\n", elem_name);
      printf("N: %d\n", CP_N);
      printf("Total Permutations: %llu\n", total_perms);
      printf("Time: %.6f\n", duration);
      printf("Speed: %.2f\n", (total_perms / duration) / 1e9);
+     if (rcpa::OPCOUNT_ENABLED) {
+         rcpa::write_opcount_report(stdout, rcpa::op_counts());
+         printf("\n");
+     }
+ }
+ 
+ // report<T, CP_N> compiled for one ISA variant (see rcpa::dispatch)
+ template <typename T, int CP_N>
+ struct ReportKernel {
+     const char* elem_name;
+     rcpa::Isa isa;
+ 
+     template <class Tag>
+     void operator()(Tag) { report<T, CP_N>(elem_name, isa); }
+ };
+ 
+ // Table entry for one N (see rcpa::dispatch_size); each N is dispatched to
+ // the ISA variant on its own.
+ struct SizedReport {
+     bool want_int;
+     bool want_u16;
+     bool want_u8;
+     rcpa::Isa isa;
+ 
+     template <int CP_N>
+     void run() {
+         ReportKernel<int, CP_N> kernel_int = { "int", isa };
+         ReportKernel<uint16_t, CP_N> kernel_u16 = { "uint16_t", isa };
+         ReportKernel<uint8_t, CP_N> kernel_u8 = { "uint8_t", isa };
+         if (want_int) rcpa::dispatch(isa, kernel_int);
+         if (want_u16) rcpa::dispatch(isa, kernel_u16);
+         if (want_u8) rcpa::dispatch(isa, kernel_u8);
+     }
+ };
+ 
+ // Usage: ./benchmark_bin [int|u16|u8|all] [--isa=scalar|sse4.2|avx2|avx512] [--n=N]
+ //   element type of D (default int); kernel variant (default: best supported);
+ //   N in [MIN_CP_N, MAX_CP_N] (default PP_N + 2)
+ int main(int argc, char* argv[]) {
+     const char* elem = "int";
+     const char* isa_flag = NULL;
+     int n_val = PP_N + 2;
+     for (int a = 1; a < argc; a++) {
+         if (std::strncmp(argv[a], "--isa=", 6) == 0) isa_flag = argv[a] + 6;
+         else if (std::strncmp(argv[a], "--n=", 4) == 0) n_val = std::atoi(argv[a] + 4);
+         else elem = argv[a];
+     }
+     if (n_val < MIN_CP_N || n_val > MAX_CP_N) {
+         fprintf(stderr, "Error: n must be in [%d, %d].\n", MIN_CP_N, MAX_CP_N);
+         return 1;
+     }
+     const bool all = (std::strcmp(elem, "all") == 0);
+     const bool want_int = all || std::strcmp(elem, "int") == 0;
+     const bool want_u16 = all || std::strcmp(elem, "u16") == 0;
+     const bool want_u8 = all || std::strcmp(elem, "u8") == 0;
+     if (!want_int && !want_u16 && !want_u8) {
+         fprintf(stderr, "Usage: %s [int|u16|u8|all] [--isa=scalar|sse4.2|avx2|avx512] [--n=N]\n", argv[0]);
+         return 1;
+     }
+     rcpa::Isa isa;
+     if (!rcpa::resolve_isa(isa_flag, isa)) return 1;
+ 
+     // Core binding should be performed before main logic execution
+     bind_to_core(0);
+ 
+     SizedReport sized = { want_int, want_u16, want_u8, isa };
+     rcpa::dispatch_size<MIN_CP_N, MAX_CP_N>(n_val, sized);
  
      return 0;
  }
@@ -0,0 +1,474 @@
+/**
+ * @file    rcpa.hpp
+ * @brief   Header-only Ring-Cascade-Permutation-Algorithm (RCPA) generator library.
+ * @author  YUSHENG-HU
+ * @details
+ * Exposes the cascade of Ring_Cascade_Permutation_Algorithm.cpp as a reusable
+ * generator object instead of a loop embedded in main(). The generator keeps
+ * the same state as the benchmark executable:
+ *   - C[]    : cascade counters, C[i] in [0, i].
+ *   - D_flat : N rows of 3*N elements. Row j (j <= N-3) holds a rotation of
+ *              row j-1 followed by j and its mirror; row N-1 is the ring buffer
+ *              (P1/P2/P3 segments).
+ *
+ * Every ring state is a pointer `ring` into row N-1 such that the N windows
+ * ring + 0 ... ring + N-1 are N distinct permutations (cyclic rotations of one
+ * sequence). Visitors receive these pointers directly; nothing is copied.
+ *
+ * Two front-ends share one engine:
+ *   - rcpa::Generator<N, T>     : order fixed at compile time, all offsets fold.
+ *   - rcpa::DynamicGenerator<T> : order chosen at runtime (D_flat on the heap).
+ * T is the element type of D_flat (int by default, uint8_t / uint16_t for
+ * narrower rows).
+ *
+ * Usage:
+ *   rcpa::Generator<12> gen;
+ *   gen.for_each([&](const int* perm) { score(perm); });          // N! calls
+ *   gen.for_each_ring([&](const int* ring) { ... ring + h ... });  // (N-1)! calls
+ *   rcpa::DynamicGenerator<uint8_t> bytes(n);                      // byte-wide rows
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_HPP
+#define RCPA_HPP
+
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "rcpa_opcount.hpp"
+
+#if defined(__GNUC__)
+#define RCPA_INLINE inline __attribute__((always_inline))
+#else
+#define RCPA_INLINE inline
+#endif
+
+namespace rcpa {
+
+inline unsigned long long factorial(int n) {
+    unsigned long long res = 1;
+    for (int i = 1; i <= n; i++) res *= i;
+    return res;
+}
+
+// Number of independent subtrees when the counters C[1..depth] are fixed.
+// C[0] is always 0, so a prefix of depth k selects one of (k+1)! shards.
+inline unsigned long long shard_count(int depth) {
+    return factorial(depth + 1);
+}
+
+// --- Rank / Unrank (RCPA order) ---
+//
+// The index of a permutation in RCPA order is
+//   k = (block * (N-1) + ring_index) * N + ring_head
+// where block is C[1..N-3] read as a mixed-radix number (C[i] in [0, i],
+// C[1] most significant), ring_index selects one of the N-1 ring states of
+// the block and ring_head one of its N windows. Both directions are O(N^2).
+
+// Writes the k-th permutation (0 <= k < N!) of RCPA order into perm[0..N-1].
+template <typename T>
+inline void unrank(int n, unsigned long long k, T* perm) {
+    const int ring_head = static_cast<int>(k % n);
+    k /= n;
+    const int ring_index = static_cast<int>(k % (n - 1));
+    k /= (n - 1);
+
+    std::vector<int> C(static_cast<size_t>(n), 0);
+    for (int i = n - 3; i > 0; i--) {
+        C[i] = static_cast<int>(k % static_cast<unsigned long long>(i + 1));
+        k /= static_cast<unsigned long long>(i + 1);
+    }
+
+    // Row j is the window of row j-1 at C[j-1] followed by j.
+    std::vector<int> row(static_cast<size_t>(n)), next(static_cast<size_t>(n));
+    row[0] = 0;
+    for (int j = 1; j <= n - 3; j++) {
+        for (int t = 0; t < j; t++) next[t] = row[(C[j - 1] + t) % j];
+        next[j] = j;
+        row.swap(next);
+    }
+
+    // Ring sequence S = [window of row N-3 at C[N-3], N-2]; ring state r is
+    // S rotated to start at S[r] followed by N-1.
+    std::vector<int> S(static_cast<size_t>(n - 1));
+    for (int t = 0; t < n - 2; t++) S[t] = row[(C[n - 3] + t) % (n - 2)];
+    S[n - 2] = n - 2;
+    for (int t = 0; t < n; t++) {
+        const int pos = (ring_head + t) % n;
+        perm[t] = static_cast<T>((pos == n - 1) ? n - 1 : S[(ring_index + pos) % (n - 1)]);
+    }
+}
+
+// Index of perm[0..N-1] in RCPA order; inverse of unrank().
+template <typename T>
+inline unsigned long long rank(int n, const T* perm) {
+    int pos = 0;
+    while (perm[pos] != n - 1) pos++;
+    const int ring_head = (n - 1 - pos + n) % n;
+
+    // R = perm rotated back to ring_head 0; R[N-1] == N-1.
+    std::vector<int> R(static_cast<size_t>(n));
+    for (int t = 0; t < n; t++) R[t] = perm[(t - ring_head + n) % n];
+
+    int q = 0;
+    while (R[q] != n - 2) q++;
+    const int ring_index = (n - 2 - q + (n - 1)) % (n - 1);
+
+    // Undo each rotation from row N-3 down to row 1, recovering C[j].
+    std::vector<int> X(static_cast<size_t>(n)), row(static_cast<size_t>(n));
+    for (int t = 0; t < n - 2; t++) X[t] = R[(t - ring_index + (n - 1)) % (n - 1)];
+    std::vector<int> C(static_cast<size_t>(n), 0);
+    for (int j = n - 3; j >= 1; j--) {
+        int p = 0;
+        while (X[p] != j) p++;
+        C[j] = (j - p + (j + 1)) % (j + 1);
+        for (int t = 0; t <= j; t++) row[t] = X[(t - C[j] + (j + 1)) % (j + 1)];
+        X.swap(row);
+    }
+
+    unsigned long long block = 0;
+    for (int i = 1; i <= n - 3; i++) block = block * static_cast<unsigned long long>(i + 1) + C[i];
+    return (block * static_cast<unsigned long long>(n - 1) + ring_index) * n + ring_head;
+}
+
+// --- Storage Policies ---
+
+// Element type T of D_flat: uint8_t / uint16_t / int. Counters stay int.
+// With uint8_t a 3N ring row of N <= 21 fits in one 64-byte cache line and
+// every cascade memcpy moves a quarter of the int bytes.
+
+// Compile-time order: C[] and D_flat are fixed-size members.
+template <int N, typename T = int>
+struct StaticStorage {
+    static_assert(N > 3, "RCPA logic requires N > 3");
+    static_assert(N - 1 <= static_cast<long long>(std::numeric_limits<T>::max()),
+                  "element type too narrow for N");
+    typedef T value_type;
+
+    explicit StaticStorage(int = N) {}
+
+    static constexpr int n() { return N; }
+    int* counters() { return C; }
+    const int* counters() const { return C; }
+    T* rows() { return D_flat; }
+    const T* rows() const { return D_flat; }
+
+    int C[N];
+    alignas(64) T D_flat[N * 3 * N];
+};
+
+// Runtime order: C[] and D_flat live on the heap.
+template <typename T = int>
+struct DynamicStorage {
+    typedef T value_type;
+
+    explicit DynamicStorage(int n)
+        : n_(n), C(static_cast<size_t>(n)), D_flat(static_cast<size_t>(n) * 3 * n) {}
+
+    int n() const { return n_; }
+    int* counters() { return C.data(); }
+    const int* counters() const { return C.data(); }
+    T* rows() { return D_flat.data(); }
+    const T* rows() const { return D_flat.data(); }
+
+    int n_;
+    std::vector<int> C;
+    std::vector<T> D_flat;
+};
+
+// --- Generator Engine ---
+
+template <class Storage>
+class BasicGenerator {
+public:
+    typedef typename Storage::value_type value_type;
+
+    explicit BasicGenerator(int n = 0) : s_(n) { reset(); }
+
+    int size() const { return s_.n(); }
+    unsigned long long count() const { return factorial(size()); }
+
+    const int* counters() const { return s_.counters(); }
+    const value_type* row(int i) const { return s_.rows() + static_cast<size_t>(i) * (3 * s_.n()); }
+
+    // Rewind to the first permutation (identity rows, all counters zero).
+    void reset() {
+        const int n = s_.n();
+        int* C = s_.counters();
+        std::memset(C, 0, static_cast<size_t>(n) * sizeof(int));
+        std::memset(s_.rows(), 0, static_cast<size_t>(n) * 3 * n * sizeof(value_type));
+        for (int i = 0; i < n; i++) {
+            value_type* D = row_ptr(i);
+            for (int j = 0; j < i; j++) {
+                D[j] = static_cast<value_type>(j);
+                D[j + i + 1] = static_cast<value_type>(j);
+            }
+            D[i] = static_cast<value_type>(i);
+        }
+        level_ = n - 4;
+        ring_index_ = 0;
+        ring_head_ = 0;
+    }
+
+    // Position the generator on permutation k (unrank into generator state):
+    // C[], rows 1..N-3, the ring row advanced to ring_index(), and ring_head().
+    void seek(unsigned long long k) {
+        const int n = s_.n();
+        const int last = n - 1;
+        ring_head_ = static_cast<int>(k % n);
+        k /= n;
+        const int target = static_cast<int>(k % (n - 1));
+        seek_shard(n - 3, k / (n - 1));
+        for (int j = 1; j < n - 2; j++) cascade_row(j);
+        load_ring();
+        value_type* ring = row_ptr(last);
+        for (ring_index_ = 0; ring_index_ < target; ring_index_++) {
+            ring[last + ring_index_] = ring[n + ring_index_];
+            ring[n + ring_index_] = static_cast<value_type>(last);
+        }
+        level_ = n - 3;
+    }
+
+    int ring_index() const { return ring_index_; }
+    int ring_head() const { return ring_head_; }
+
+    // Permutation at the current position (valid after seek()).
+    const value_type* current() const { return row(size() - 1) + ring_index_ + ring_head_; }
+
+    // Ring state at the current position (valid after seek()); its N windows
+    // ring() + 0 ... ring() + N-1 are the permutations of that state.
+    const value_type* ring() const { return row(size() - 1) + ring_index_; }
+
+    // Step to the next ring state (next block after the last ring index).
+    // Valid after seek(); the caller stops after the last of the (N-1)! states.
+    RCPA_INLINE void next_ring() {
+        const int n = s_.n();
+        const int last = n - 1;
+        value_type* ring = row_ptr(last);
+        ring[last + ring_index_] = ring[n + ring_index_];
+        ring[n + ring_index_] = static_cast<value_type>(last);
+        RCPA_COUNT_OP(ring_updates, 1);
+        if (++ring_index_ < last) return;
+        next_block();
+    }
+
+    // Carry into the next block and rebuild the stale rows and the ring row.
+    void next_block() {
+        const int n = s_.n();
+        const int third_last = n - 3;
+        int* C = s_.counters();
+        int i_loop;
+        C[third_last]++;
+        for (i_loop = third_last; (i_loop > 0) && (C[i_loop] > i_loop); i_loop--) {
+            RCPA_COUNT_CARRY(i_loop);
+            C[i_loop] = 0;
+            C[i_loop - 1]++;
+        }
+        for (int j = i_loop + 1; j < n - 2; j++) cascade_row(j);
+        load_ring();
+        ring_index_ = 0;
+        level_ = n - 3;
+    }
+
+    // Calls visit(const value_type* perm) for the permutations with RCPA index in
+    // [begin, end), e.g. one slice of a multi-process split.
+    template <class Visitor>
+    void run_range(unsigned long long begin, unsigned long long end, Visitor&& visit) {
+        const unsigned long long total = count();
+        if (end > total) end = total;
+        if (begin >= end) return;
+
+        seek(begin);
+        const int n = s_.n();
+        const value_type* ring = row_ptr(n - 1);
+        unsigned long long left = end - begin;
+        for (;;) {
+            const value_type* base = ring + ring_index_;
+            const int h_end = (left < static_cast<unsigned long long>(n - ring_head_))
+                                  ? ring_head_ + static_cast<int>(left) : n;
+            for (int h = ring_head_; h < h_end; h++) visit(base + h);
+            RCPA_COUNT_OP(perms, h_end - ring_head_);
+            left -= static_cast<unsigned long long>(h_end - ring_head_);
+            if (left == 0) {
+                ring_head_ = h_end - 1;
+                break;
+            }
+            ring_head_ = 0;
+            next_ring();
+        }
+    }
+
+    // Calls visit(const value_type* ring) once per ring state; the N windows
+    // ring + 0 ... ring + N-1 are the permutations of that state.
+    template <class Visitor>
+    void for_each_ring(Visitor&& visit) {
+        reset();
+        run_rings(visit);
+    }
+
+    // Calls visit(const value_type* perm) once for each of the N! permutations.
+    template <class Visitor>
+    void for_each(Visitor&& visit) {
+        const int n = s_.n();
+        for_each_ring([&](const value_type* ring) {
+            for (int h = 0; h < n; h++) visit(ring + h);
+        });
+    }
+
+    // Fix C[1..depth] to the digits of `shard` (mixed radix, C[1] most
+    // significant) and zero the deeper counters. 0 <= depth <= N-3.
+    void seek_shard(int depth, unsigned long long shard) {
+        const int n = s_.n();
+        int* C = s_.counters();
+        std::memset(C, 0, static_cast<size_t>(n) * sizeof(int));
+        for (int i = depth; i > 0; i--) {
+            C[i] = static_cast<int>(shard % static_cast<unsigned long long>(i + 1));
+            shard /= static_cast<unsigned long long>(i + 1);
+        }
+        level_ = 0;
+    }
+
+    // Ring states of one shard only; shards of the same depth are disjoint
+    // and together cover all N! permutations in RCPA order.
+    template <class Visitor>
+    void for_each_ring_in_shard(int depth, unsigned long long shard, Visitor&& visit) {
+        seek_shard(depth, shard);
+        run_rings(visit, depth);
+    }
+
+    // Branch and bound: prune(int j, const value_type* row) is called for each
+    // cascade row j = 1 .. N-2 as it is built. row[0..j] is the cyclic order of
+    // 0..j that every permutation below it keeps (row N-2 is the ring base
+    // [B, N-2]). Returning true skips the (N-1)!/j! ring states below the row
+    // without building them; the surviving ring states are visited in RCPA
+    // order.
+    template <class Prune, class Visitor>
+    void for_each_ring_pruned(Prune&& prune, Visitor&& visit) {
+        reset();
+        level_ = 0;  // reset() prebuilds rows 1..N-4; every row must pass the hook
+        run_rings(visit, 0, prune);
+    }
+
+    // Pruned enumeration of one shard (see for_each_ring_in_shard).
+    template <class Prune, class Visitor>
+    void for_each_ring_in_shard_pruned(int depth, unsigned long long shard, Prune&& prune, Visitor&& visit) {
+        seek_shard(depth, shard);
+        run_rings(visit, depth, prune);
+    }
+
+protected:
+    RCPA_INLINE value_type* row_ptr(int i) { return s_.rows() + static_cast<size_t>(i) * (3 * s_.n()); }
+
+    // Rebuild row j from the window of row j-1 selected by C[j-1].
+    RCPA_INLINE void cascade_row(int j) {
+        const value_type* src_ptr = row_ptr(j - 1) + s_.counters()[j - 1];
+        value_type* D = row_ptr(j);
+        std::memcpy(D, src_ptr, static_cast<size_t>(j) * sizeof(value_type));
+        std::memcpy(D + j + 1, src_ptr, static_cast<size_t>(j) * sizeof(value_type));
+        RCPA_COUNT_OP(cascade_bytes, 2 * static_cast<size_t>(j) * sizeof(value_type));
+    }
+
+    // Fill the P1/P2/P3 segments of the ring row from row N-3.
+    RCPA_INLINE void load_ring() {
+        const int n = s_.n();
+        const int last = n - 1;
+        const int second_last = n - 2;
+        const int third_last = n - 3;
+        const size_t memcpy_size = static_cast<size_t>(second_last) * sizeof(value_type);
+
+        value_type* P1 = row_ptr(last);
+        value_type* P2 = P1 + n;
+        value_type* P3 = P1 + (n * 2 - 1);
+        const value_type* src_ptr = row_ptr(third_last) + s_.counters()[third_last];
+        std::memcpy(P1, src_ptr, memcpy_size);
+        P1[second_last] = static_cast<value_type>(second_last);
+        P1[last] = static_cast<value_type>(last);
+        std::memcpy(P2, src_ptr, memcpy_size);
+        P2[second_last] = static_cast<value_type>(second_last);
+        std::memcpy(P3, src_ptr, memcpy_size);
+        RCPA_COUNT_OP(cascade_bytes, 3 * memcpy_size);
+    }
+
+    // Main cascade: continues from the current counters until the carry
+    // reaches C[top] (top = 0 is the full enumeration). A row the prune hook
+    // rejects is not expanded: its counter C[j-1] advances at once.
+    template <class Visitor, class Prune>
+    void run_rings(Visitor& visit, int top, Prune& prune) {
+        const int n = s_.n();
+        const int last = n - 1;
+        const int second_last = n - 2;
+        const int third_last = n - 3;
+        int* C = s_.counters();
+        value_type* ring = row_ptr(last);
+
+        int i_loop = level_;
+        for (;;) {
+            // Row N-2 is never read by the ring stage, so the cascade stops at N-3.
+            int j = i_loop + 1;
+            for (; j < second_last; j++) {
+                cascade_row(j);
+                if (prune(j, static_cast<const value_type*>(row_ptr(j)))) break;
+            }
+            if (j < second_last) {
+                i_loop = j - 1;
+            } else {
+                load_ring();
+                if (!prune(second_last, static_cast<const value_type*>(ring))) {
+                    for (int ring_index = 0; ring_index < last; ring_index++) {
+                        visit(static_cast<const value_type*>(ring + ring_index));
+                        ring[last + ring_index] = ring[n + ring_index];
+                        ring[n + ring_index] = static_cast<value_type>(last);
+                    }
+                    RCPA_COUNT_OP(perms, n * last);
+                    RCPA_COUNT_OP(ring_updates, last);
+                }
+                i_loop = third_last;
+            }
+
+            C[i_loop]++;
+            for (; (i_loop > top) && (C[i_loop] > i_loop); i_loop--) {
+                RCPA_COUNT_CARRY(i_loop);
+                C[i_loop] = 0;
+                C[i_loop - 1]++;
+            }
+            if (i_loop <= top) break;
+        }
+        level_ = i_loop;
+    }
+
+    template <class Visitor>
+    void run_rings(Visitor& visit, int top = 0) {
+        NoPrune prune;
+        run_rings(visit, top, prune);
+    }
+
+    struct NoPrune {
+        RCPA_INLINE bool operator()(int, const value_type*) const { return false; }
+    };
+
+    Storage s_;
+    int level_ = 0;  // Counter touched by the last carry; rows j > level_ are stale.
+    int ring_index_ = 0;
+    int ring_head_ = 0;
+};
+
+template <int N, typename T = int>
+class Generator : public BasicGenerator<StaticStorage<N, T> > {
+public:
+    explicit Generator(int = N) : BasicGenerator<StaticStorage<N, T> >(N) {}
+};
+
+template <typename T = int>
+class DynamicGenerator : public BasicGenerator<DynamicStorage<T> > {
+public:
+    explicit DynamicGenerator(int n) : BasicGenerator<DynamicStorage<T> >(n) {}
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_HPP
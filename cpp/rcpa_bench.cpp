@@ -0,0 +1,339 @@
+/**
+ * @file rcpa_bench.cpp
+ * @brief Unified benchmark harness for all permutation generators
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Registers the generators of the separate benchmark mains (Heap, PP,
+ * RCPA cascade, PP + ring, SIMD lanes, multi-threaded RCPA) with the
+ * harness of rcpa_bench.hpp and measures each of them for every requested
+ * N with warmup and repeated runs. N is a runtime argument for all cases;
+ * the PP + ring cases pick the compile-time generator for N = 4..20 from the
+ * table of rcpa::dispatch_size().
+ *
+ * Every case feeds the same kind of O(1) consumer: per permutation for the
+ * per-permutation algorithms, per ring state for the ring-based ones, so the
+ * numbers compare the generators rather than the checksums of the mains.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_bench.cpp -o rcpa_bench -pthread
+ * Usage: ./rcpa_bench [--gen=NAME,...|all] [--n=LIST] [--reps=R] [--warmup=W]
+ *                     [--cpu=K|none] [--isa=NAME] [--format=text|json|csv] [--out=FILE] [--perf] [--list]
+ *   --n      : comma-separated values or ranges, e.g. 10,12 or 9-12 (default 11)
+ *   --cpu    : pin the harness to core K (default 1, or 0 on one core);
+ *              the parallel case pins its own workers
+ *   --perf   : add hardware counters per permutation (rcpa_perf.hpp; counts
+ *              the harness thread only, so not the parallel workers)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rcpa_bench.hpp"
+#include "rcpa_lanes.hpp"
+#include "rcpa_parallel.hpp"
+#include "rcpa_pp.hpp"
+
+// --- Built-in Cases ---
+
+// Heap's algorithm (heap_perm.cpp).
+struct HeapKernel {
+    int n;
+    unsigned long long checksum;
+
+    template <class Tag>
+    void operator()(Tag) {
+        std::vector<int> D(n), c(n, 0);
+        for (int k = 0; k < n; k++) D[k] = k;
+        unsigned long long sum = D[n - 1];
+        int i = 1;
+        while (i < n) {
+            if (c[i] < i) {
+                if (i % 2 == 0) std::swap(D[0], D[i]);
+                else std::swap(D[c[i]], D[i]);
+                sum += D[n - 1];
+                c[i]++;
+                i = 1;
+            } else {
+                c[i] = 0;
+                i++;
+            }
+        }
+        checksum = sum;
+    }
+};
+
+// Position-Pure algorithm (permpure_full.cpp).
+template <typename T>
+struct PermpureKernel {
+    int n;
+    unsigned long long checksum;
+
+    template <class Tag>
+    void operator()(Tag) {
+        std::vector<int> C(n, 0);
+        std::vector<T> D(n, 0);
+        unsigned long long sum = 0;
+        int i = 0;
+        while (C[0] < 1) {
+            for (; i < n - 1; ++i) {
+                D[i] = D[C[i]];
+                D[C[i]] = static_cast<T>(i);
+            }
+            for (int ii = 0; ii < n; ii++) {
+                D[n - 1] = D[ii];
+                D[ii] = static_cast<T>(n - 1);
+                sum += D[n - 1];
+                D[ii] = D[n - 1];
+            }
+            D[C[n - 2]] = D[n - 2];
+            C[n - 2]++;
+            for (i = n - 2; (i > 0) && (C[i] > i); i--) {
+                C[i] = 0;
+                C[i - 1]++;
+                D[C[i - 1] - 1] = D[i - 1];
+            }
+        }
+        checksum = sum;
+    }
+};
+
+// Ring-state checksum shared by the ring-based cases.
+template <typename T>
+struct RingSum {
+    int n;
+    unsigned long long sum;
+
+    RCPA_INLINE void operator()(const T* ring) { sum += static_cast<unsigned long long>(ring[0]) * n + ring[n - 1]; }
+};
+
+// Runtime-N cascade (Ring_Cascade_Permutation_Algorithm.cpp).
+template <typename T>
+struct RcpaKernel {
+    int n;
+    unsigned long long checksum;
+
+    template <class Tag>
+    void operator()(Tag) {
+        rcpa::DynamicGenerator<T> generator(n);
+        RingSum<T> visit = { n, 0 };
+        generator.for_each_ring(visit);
+        checksum = visit.sum;
+    }
+};
+
+// PP + ring (ppa_rcpa.cpp): int rows with the scalar burst, or uint8_t rows
+// with the burst of the dispatched ISA variant (ppa_rcpa_simd.cpp).
+template <int N, typename T, bool SIMD>
+struct PPRingKernel {
+    unsigned long long checksum;
+
+    template <class Tag>
+    void operator()(Tag) {
+        typedef typename rcpa::BurstFor<Tag::value>::type SimdBurst;
+        typedef typename std::conditional<SIMD, SimdBurst, rcpa::BurstScalar>::type Burst;
+        rcpa::PPRingGenerator<N, T, Burst> generator;
+        RingSum<T> visit = { N, 0 };
+        generator.for_each_ring(visit);
+        checksum = visit.sum;
+    }
+};
+
+// Table entry for one N (rcpa::dispatch_size); dispatches the ISA itself.
+template <typename T, bool SIMD>
+struct PPRingSized {
+    rcpa::Isa isa;
+    unsigned long long checksum;
+
+    template <int N>
+    void run() {
+        PPRingKernel<N, T, SIMD> kernel = { 0 };
+        rcpa::dispatch(isa, kernel);
+        checksum = kernel.checksum;
+    }
+};
+
+template <typename T, bool SIMD>
+unsigned long long run_pp_ring(int n, rcpa::Isa isa) {
+    PPRingSized<T, SIMD> sized = { isa, 0 };
+    rcpa::dispatch_size<rcpa::PP_MIN_N, rcpa::PP_MAX_N>(n, sized);
+    return sized.checksum;
+}
+
+// 16 shards in lockstep on one core (rcpa_lanes.cpp).
+struct LaneKernel {
+    int n;
+    unsigned long long checksum;
+
+    template <class Tag>
+    void operator()(Tag) {
+        rcpa::LaneGenerator<uint8_t, 16> generator(n);
+        unsigned long long sum = 0;
+        const int n_val = n;
+        generator.for_each_ring([&](const uint8_t* ring, int live) {
+            const uint8_t* tail = ring + (n_val - 1) * 16;
+            for (int l = 0; l < live; l++) sum += static_cast<unsigned long long>(ring[l] * n_val + tail[l]);
+        });
+        checksum = sum;
+    }
+};
+
+template <class Kernel>
+unsigned long long run_dispatched(int n, rcpa::Isa isa) {
+    Kernel kernel = { n, 0 };
+    rcpa::dispatch(isa, kernel);
+    return kernel.checksum;
+}
+
+// All cores (rcpa_parallel.cpp); workers are not ISA-dispatched.
+unsigned long long run_parallel(int n, rcpa::Isa) {
+    RingSum<uint8_t> proto = { n, 0 };
+    std::vector<RingSum<uint8_t> > parts = rcpa::parallel_for_each_ring<uint8_t>(n, 0, proto);
+    unsigned long long sum = 0;
+    for (const RingSum<uint8_t>& p : parts) sum += p.sum;
+    return sum;
+}
+
+void register_builtin(rcpa::BenchRegistry& reg) {
+    reg.add("heap", "Heap's algorithm, int", 2, 20, &run_dispatched<HeapKernel>);
+    reg.add("permpure", "Position-Pure algorithm, int", 2, 20, &run_dispatched<PermpureKernel<int> >);
+    reg.add("rcpa", "runtime-N cascade, int rows", 4, 20, &run_dispatched<RcpaKernel<int> >);
+    reg.add("rcpa_u8", "runtime-N cascade, uint8_t rows", 4, 20, &run_dispatched<RcpaKernel<uint8_t> >);
+    reg.add("pp_ring", "PP + ring, int rows, scalar burst", rcpa::PP_MIN_N, rcpa::PP_MAX_N,
+            &run_pp_ring<int, false>);
+    reg.add("pp_ring_u8", "PP + ring, uint8_t rows, ISA burst", rcpa::PP_MIN_N, rcpa::PP_MAX_N,
+            &run_pp_ring<uint8_t, true>);
+    reg.add("lanes16", "16 SoA lanes on one core, uint8_t", 4, 20, &run_dispatched<LaneKernel>);
+    reg.add("parallel", "sharded cascade on all cores, uint8_t", 4, 20, &run_parallel);
+}
+
+// "10,12" or "9-12" or a mix.
+bool parse_n_list(const char* s, std::vector<int>& out) {
+    out.clear();
+    while (*s) {
+        char* end;
+        const long lo = std::strtol(s, &end, 10);
+        if (end == s) return false;
+        long hi = lo;
+        s = end;
+        if (*s == '-') {
+            hi = std::strtol(s + 1, &end, 10);
+            if (end == s + 1) return false;
+            s = end;
+        }
+        for (long v = lo; v <= hi; v++) out.push_back(static_cast<int>(v));
+        if (*s == ',') s++;
+        else if (*s) return false;
+    }
+    return !out.empty();
+}
+
+int main(int argc, char* argv[]) {
+    rcpa::BenchRegistry reg;
+    register_builtin(reg);
+
+    // --- Parse Command Line Argument ---
+    std::string gen_list = "all";
+    std::vector<int> n_values(1, 11);
+    const char* isa_flag = NULL;
+    const char* format = "text";
+    const char* out_path = NULL;
+    int cpu = std::thread::hardware_concurrency() > 1 ? 1 : 0;
+    rcpa::BenchOptions opt;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--gen=", 6) == 0) {
+            gen_list = argv[a] + 6;
+        } else if (std::strncmp(argv[a], "--n=", 4) == 0) {
+            if (!parse_n_list(argv[a] + 4, n_values)) {
+                fprintf(stderr, "Error: bad N list '%s' (e.g. 10,12 or 9-12).\n", argv[a] + 4);
+                return 1;
+            }
+        } else if (std::strncmp(argv[a], "--reps=", 7) == 0) {
+            opt.reps = std::atoi(argv[a] + 7);
+        } else if (std::strncmp(argv[a], "--warmup=", 9) == 0) {
+            opt.warmup = std::atoi(argv[a] + 9);
+        } else if (std::strncmp(argv[a], "--cpu=", 6) == 0) {
+            cpu = std::strcmp(argv[a] + 6, "none") == 0 ? -1 : std::atoi(argv[a] + 6);
+        } else if (std::strncmp(argv[a], "--isa=", 6) == 0) {
+            isa_flag = argv[a] + 6;
+        } else if (std::strncmp(argv[a], "--format=", 9) == 0) {
+            format = argv[a] + 9;
+        } else if (std::strncmp(argv[a], "--out=", 6) == 0) {
+            out_path = argv[a] + 6;
+        } else if (std::strcmp(argv[a], "--perf") == 0) {
+            opt.perf = true;
+        } else if (std::strcmp(argv[a], "--list") == 0) {
+            for (const rcpa::BenchCase& c : reg.cases()) {
+                printf("%-12s N %2d..%-2d  %s\n", c.name.c_str(), c.min_n, c.max_n, c.description.c_str());
+            }
+            return 0;
+        } else {
+            fprintf(stderr, "Usage: %s [--gen=NAME,...|all] [--n=LIST] [--reps=R] [--warmup=W] [--cpu=K|none]"
+                            " [--isa=NAME] [--format=text|json|csv] [--out=FILE] [--perf] [--list]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (std::strcmp(format, "text") != 0 && std::strcmp(format, "json") != 0 && std::strcmp(format, "csv") != 0) {
+        fprintf(stderr, "Error: unknown format '%s' (text|json|csv).\n", format);
+        return 1;
+    }
+    if (opt.reps < 1 || opt.warmup < 0) {
+        fprintf(stderr, "Error: --reps must be >= 1 and --warmup >= 0.\n");
+        return 1;
+    }
+    if (!rcpa::resolve_isa(isa_flag, opt.isa)) return 1;
+
+    std::vector<const rcpa::BenchCase*> selected;
+    if (gen_list == "all") {
+        for (const rcpa::BenchCase& c : reg.cases()) selected.push_back(&c);
+    } else {
+        size_t pos = 0;
+        while (pos <= gen_list.size()) {
+            const size_t comma = gen_list.find(',', pos);
+            const std::string name = gen_list.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+            const rcpa::BenchCase* c = reg.find(name);
+            if (c == nullptr) {
+                fprintf(stderr, "Error: unknown generator '%s' (see --list).\n", name.c_str());
+                return 1;
+            }
+            selected.push_back(c);
+            if (comma == std::string::npos) break;
+            pos = comma + 1;
+        }
+    }
+
+    if (cpu >= 0) rcpa::pin_thread_to_core(static_cast<unsigned>(cpu));
+
+    std::vector<rcpa::BenchResult> results;
+    for (int n : n_values) {
+        for (const rcpa::BenchCase* c : selected) {
+            if (n < c->min_n || n > c->max_n) {
+                fprintf(stderr, "Skipping %s for N=%d (supports %d..%d).\n", c->name.c_str(), n, c->min_n, c->max_n);
+                continue;
+            }
+            results.push_back(rcpa::run_bench(*c, n, opt));
+        }
+    }
+
+    FILE* out = stdout;
+    if (out_path != NULL && (out = fopen(out_path, "w")) == NULL) {
+        fprintf(stderr, "Error: cannot open %s.\n", out_path);
+        return 1;
+    }
+    if (std::strcmp(format, "json") == 0) rcpa::write_bench_json(out, results);
+    else if (std::strcmp(format, "csv") == 0) rcpa::write_bench_csv(out, results);
+    else rcpa::write_bench_report(out, results);
+    if (out != stdout) fclose(out);
+
+    for (const rcpa::BenchResult& r : results) {
+        if (!r.checksum_stable) {
+            fprintf(stderr, "Error: %s N=%d returned different checksums across runs.\n", r.name.c_str(), r.n);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,283 @@
+/**
+ * @file    rcpa_bench.hpp
+ * @brief   Benchmark harness: generator registry, repeated runs, statistics.
+ * @author  YUSHENG-HU
+ * @details
+ * The per-algorithm mains each time a single run and print their own format.
+ * Here every generator is a registered BenchCase, and all of them are measured
+ * the same way:
+ *
+ *   - `warmup` untimed runs, then `reps` timed runs per (case, N);
+ *   - wall time (steady_clock) and TSC ticks around each run;
+ *   - median / min / max / mean / stddev of the wall times, perms/s and
+ *     cycles/perm from the median run (TSC ticks, i.e. reference cycles at
+ *     the nominal clock; "n/a" where no TSC is available);
+ *   - the checksum of every run, which must not change between runs;
+ *   - with `perf`, the hardware counters of rcpa_perf.hpp for every run,
+ *     reported per permutation for the median run.
+ *
+ * A case runs `run(n, isa)` and returns its checksum; the built-in cases
+ * (rcpa_bench.cpp) dispatch their kernel for the selected ISA variant
+ * (rcpa_dispatch.hpp). Results are written as REPORT blocks, JSON or CSV.
+ *
+ * Usage:
+ *   rcpa::BenchRegistry reg;
+ *   reg.add("rcpa", "cascade, int rows", 4, 20, &run_rcpa);
+ *   rcpa::BenchResult r = rcpa::run_bench(*reg.find("rcpa"), 12, opt);
+ *   rcpa::write_bench_csv(stdout, results);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_BENCH_HPP
+#define RCPA_BENCH_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "rcpa.hpp"
+#include "rcpa_dispatch.hpp"
+#include "rcpa_perf.hpp"
+
+namespace rcpa {
+
+// --- Cycle Counter ---
+
+inline bool have_cycle_counter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+// TSC ticks (constant rate on current x86), 0 elsewhere.
+inline unsigned long long read_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+// --- Registry ---
+
+// run(n, isa) enumerates all n! permutations once and returns a checksum.
+typedef unsigned long long (*BenchFn)(int n, Isa isa);
+
+struct BenchCase {
+    std::string name;
+    std::string description;
+    int min_n;
+    int max_n;
+    BenchFn run;
+};
+
+class BenchRegistry {
+public:
+    void add(const std::string& name, const std::string& description, int min_n, int max_n, BenchFn run) {
+        BenchCase c = { name, description, min_n, max_n, run };
+        cases_.push_back(c);
+    }
+
+    const BenchCase* find(const std::string& name) const {
+        for (const BenchCase& c : cases_) {
+            if (c.name == name) return &c;
+        }
+        return nullptr;
+    }
+
+    const std::vector<BenchCase>& cases() const { return cases_; }
+
+private:
+    std::vector<BenchCase> cases_;
+};
+
+// --- Measurement ---
+
+struct BenchOptions {
+    int warmup = 1;
+    int reps = 5;
+    Isa isa = Isa::Scalar;
+    bool perf = false;
+};
+
+struct BenchResult {
+    std::string name;
+    int n = 0;
+    Isa isa = Isa::Scalar;
+    int reps = 0;
+    unsigned long long perms = 0;
+    double median = 0.0;  // seconds
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double stddev = 0.0;  // sample standard deviation
+    double perms_per_sec = 0.0;    // from the median run
+    double cycles_per_perm = 0.0;  // from the median run, < 0 if unavailable
+    unsigned long long checksum = 0;
+    bool checksum_stable = true;   // every run returned the same checksum
+    bool perf = false;             // counters requested
+    std::string perf_error;        // why no counter could be opened
+    double perf_per_perm[PERF_EVENT_COUNT] = {};  // median run, < 0 if unavailable
+};
+
+inline BenchResult run_bench(const BenchCase& c, int n, const BenchOptions& opt) {
+    BenchResult r;
+    r.name = c.name;
+    r.n = n;
+    r.isa = opt.isa;
+    r.reps = opt.reps > 0 ? opt.reps : 1;
+    r.perms = factorial(n);
+
+    for (int w = 0; w < opt.warmup; w++) r.checksum = c.run(n, opt.isa);
+
+    PerfCounters perf;
+    r.perf = opt.perf;
+    if (opt.perf && !perf.open()) r.perf_error = perf.error();
+
+    struct Run {
+        double seconds;
+        unsigned long long cycles;
+        unsigned long long counts[PERF_EVENT_COUNT];
+
+        bool operator<(const Run& o) const { return seconds < o.seconds; }
+    };
+    std::vector<Run> runs;
+    for (int k = 0; k < r.reps; k++) {
+        Run run;
+        if (perf.any()) perf.start();
+        auto start = std::chrono::steady_clock::now();
+        const unsigned long long c0 = read_cycles();
+        const unsigned long long sum = c.run(n, opt.isa);
+        const unsigned long long c1 = read_cycles();
+        auto finish = std::chrono::steady_clock::now();
+        if (perf.any()) perf.stop();
+        run.seconds = std::chrono::duration<double>(finish - start).count();
+        run.cycles = c1 - c0;
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) run.counts[e] = perf.value(e);
+        runs.push_back(run);
+        if ((k > 0 || opt.warmup > 0) && sum != r.checksum) r.checksum_stable = false;
+        r.checksum = sum;
+    }
+
+    std::sort(runs.begin(), runs.end());
+    const size_t mid = runs.size() / 2;
+    r.min = runs.front().seconds;
+    r.max = runs.back().seconds;
+    r.median = runs.size() % 2 ? runs[mid].seconds : 0.5 * (runs[mid - 1].seconds + runs[mid].seconds);
+    const double median_cycles = runs.size() % 2 ? static_cast<double>(runs[mid].cycles)
+                                                 : 0.5 * (static_cast<double>(runs[mid - 1].cycles) +
+                                                          static_cast<double>(runs[mid].cycles));
+    double sum = 0.0;
+    for (const Run& run : runs) sum += run.seconds;
+    r.mean = sum / runs.size();
+    double sq = 0.0;
+    for (const Run& run : runs) sq += (run.seconds - r.mean) * (run.seconds - r.mean);
+    r.stddev = runs.size() > 1 ? std::sqrt(sq / (runs.size() - 1)) : 0.0;
+
+    r.perms_per_sec = r.perms / r.median;
+    r.cycles_per_perm = have_cycle_counter() ? median_cycles / r.perms : -1.0;
+    // Counters of the run with the median time (upper median for even reps).
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        r.perf_per_perm[e] = perf.available(e) ? static_cast<double>(runs[mid].counts[e]) / r.perms : -1.0;
+    }
+    return r;
+}
+
+// --- Output ---
+
+// Standardized REPORT blocks, one per result (as printed by the mains).
+inline void write_bench_report(FILE* out, const std::vector<BenchResult>& results) {
+    for (const BenchResult& r : results) {
+        fprintf(out, "\nREPORT_START");
+        fprintf(out, "\nALGORITHM: %s", r.name.c_str());
+        fprintf(out, "\nISA: %s", isa_name(r.isa));
+        fprintf(out, "\nN_VALUE: %d", r.n);
+        fprintf(out, "\nREPS: %d", r.reps);
+        fprintf(out, "\nEXECUTION_TIME: %lf", r.median);
+        fprintf(out, "\nMIN_TIME: %lf", r.min);
+        fprintf(out, "\nMAX_TIME: %lf", r.max);
+        fprintf(out, "\nSTDDEV: %lf", r.stddev);
+        fprintf(out, "\nSPEED: %.2f", r.perms_per_sec / 1e9);
+        if (r.cycles_per_perm >= 0) fprintf(out, "\nCYCLES_PER_PERM: %.3f", r.cycles_per_perm);
+        else fprintf(out, "\nCYCLES_PER_PERM: n/a");
+        fprintf(out, "\nCHECKSUM: %llu", r.checksum);
+        fprintf(out, "\nCHECKSUM_STABLE: %s", r.checksum_stable ? "YES" : "NO");
+        if (r.perf && !r.perf_error.empty()) {
+            fprintf(out, "\nPERF: unavailable (%s)", r.perf_error.c_str());
+        } else if (r.perf) {
+            fprintf(out, "\nPERF: on");
+            for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+                if (r.perf_per_perm[e] >= 0) fprintf(out, "\n%s_PER_PERM: %.4f", perf_event_name(e), r.perf_per_perm[e]);
+                else fprintf(out, "\n%s_PER_PERM: n/a", perf_event_name(e));
+            }
+        }
+        fprintf(out, "\nREPORT_END\n");
+    }
+}
+
+inline void write_bench_csv(FILE* out, const std::vector<BenchResult>& results) {
+    fprintf(out, "algorithm,isa,n,reps,perms,median_s,min_s,max_s,mean_s,stddev_s,"
+                 "perms_per_s,cycles_per_perm,checksum,checksum_stable");
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        std::string key = perf_event_name(e);
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+        fprintf(out, ",perf_%s_per_perm", key.c_str());
+    }
+    fprintf(out, "\n");
+    for (const BenchResult& r : results) {
+        fprintf(out, "%s,%s,%d,%d,%llu,%.6f,%.6f,%.6f,%.6f,%.6f,%.4e,", r.name.c_str(), isa_name(r.isa), r.n,
+                r.reps, r.perms, r.median, r.min, r.max, r.mean, r.stddev, r.perms_per_sec);
+        if (r.cycles_per_perm >= 0) fprintf(out, "%.4f", r.cycles_per_perm);
+        fprintf(out, ",%llu,%d", r.checksum, r.checksum_stable ? 1 : 0);
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (r.perf_per_perm[e] >= 0) fprintf(out, ",%.4f", r.perf_per_perm[e]);
+            else fprintf(out, ",");
+        }
+        fprintf(out, "\n");
+    }
+}
+
+inline void write_bench_json(FILE* out, const std::vector<BenchResult>& results) {
+    fprintf(out, "[\n");
+    for (size_t k = 0; k < results.size(); k++) {
+        const BenchResult& r = results[k];
+        fprintf(out, "  {\"algorithm\": \"%s\", \"isa\": \"%s\", \"n\": %d, \"reps\": %d, \"perms\": %llu,\n",
+                r.name.c_str(), isa_name(r.isa), r.n, r.reps, r.perms);
+        fprintf(out, "   \"median_s\": %.6f, \"min_s\": %.6f, \"max_s\": %.6f, \"mean_s\": %.6f, \"stddev_s\": %.6f,\n",
+                r.median, r.min, r.max, r.mean, r.stddev);
+        fprintf(out, "   \"perms_per_s\": %.4e, \"cycles_per_perm\": ", r.perms_per_sec);
+        if (r.cycles_per_perm >= 0) fprintf(out, "%.4f", r.cycles_per_perm);
+        else fprintf(out, "null");
+        fprintf(out, ", \"checksum\": %llu, \"checksum_stable\": %s", r.checksum, r.checksum_stable ? "true" : "false");
+        if (r.perf) {
+            fprintf(out, ",\n   \"perf\": {");
+            for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+                std::string key = perf_event_name(e);
+                std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+                fprintf(out, "%s\"%s_per_perm\": ", e ? ", " : "", key.c_str());
+                if (r.perf_per_perm[e] >= 0) fprintf(out, "%.4f", r.perf_per_perm[e]);
+                else fprintf(out, "null");
+            }
+            fprintf(out, "}");
+        }
+        fprintf(out, "}%s\n", k + 1 < results.size() ? "," : "");
+    }
+    fprintf(out, "]\n");
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_BENCH_HPP
@@ -0,0 +1,200 @@
+/**
+ * @file    rcpa_checkpoint.hpp
+ * @brief   Checkpoint / resume for long RCPA enumerations.
+ * @author  YUSHENG-HU
+ * @details
+ * The position of an enumeration is fully described by the counters
+ * C[1..N-3] at a ring-block boundary; the D rows are rebuilt from them. The
+ * run is split into C-prefix shards (rcpa.hpp, for_each_ring_in_shard) of at
+ * most `every` ring blocks, and the state saved between shards is just:
+ *
+ *   RCPA_CHECKPOINT 1
+ *   N 16                  ELEMENT_TYPE uint8_t
+ *   DEPTH 11              SHARDS 479001600
+ *   NEXT_SHARD 1234       RINGS / CHECKSUM  (visitor totals so far)
+ *   HASH <FNV-1a of the lines above>
+ *
+ * (one key per line). Files are written to <path>.tmp, flushed to disk and
+ * renamed over <path>, so a crash leaves either the old or the new state.
+ * SIGTERM / SIGINT only set a flag; the driver saves at the next shard
+ * boundary and returns, and a later run resumes from NEXT_SHARD. Resumed
+ * runs visit exactly the remaining ring states in RCPA order, so their
+ * totals match an uninterrupted run.
+ *
+ * Usage:
+ *   rcpa::CheckpointState st;   // visit adds to st.rings / st.checksum
+ *   if (!resume || !rcpa::load_checkpoint(path, st)) st = rcpa::new_checkpoint(n, "uint8_t", every);
+ *   rcpa::install_stop_signals();
+ *   bool done = rcpa::run_checkpointed(gen, visit, st, path, every);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_CHECKPOINT_HPP
+#define RCPA_CHECKPOINT_HPP
+
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+// --- Checkpoint State ---
+
+struct CheckpointState {
+    int n;
+    char elem[16];                  // element type name of the run
+    int depth;                      // shard depth: C[1..depth] fixed per shard
+    unsigned long long shards;      // (depth + 1)!
+    unsigned long long next_shard;  // first shard not yet visited
+    unsigned long long rings;       // ring states visited so far
+    unsigned long long checksum;    // visitor checksum so far
+};
+
+// Shard depth for checkpoints: the smallest depth whose shards hold at most
+// `every` ring blocks ((N-2)! / (depth+1)! each; depth N-3 is one block).
+inline int checkpoint_depth(int n, unsigned long long every) {
+    int depth = 0;
+    while (depth < n - 3 && factorial(n - 2) / shard_count(depth) > every) depth++;
+    return depth;
+}
+
+inline CheckpointState new_checkpoint(int n, const char* elem, unsigned long long every) {
+    CheckpointState st;
+    std::memset(&st, 0, sizeof(st));
+    st.n = n;
+    std::strncpy(st.elem, elem, sizeof(st.elem) - 1);
+    st.depth = checkpoint_depth(n, every);
+    st.shards = shard_count(st.depth);
+    return st;
+}
+
+inline unsigned long long fnv1a(const char* s, size_t len) {
+    unsigned long long h = 1469598103934665603ull;
+    for (size_t i = 0; i < len; i++) {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+inline std::string format_checkpoint(const CheckpointState& st) {
+    char body[512];
+    int len = snprintf(body, sizeof(body),
+                       "RCPA_CHECKPOINT 1\nN %d\nELEMENT_TYPE %s\nDEPTH %d\nSHARDS %llu\n"
+                       "NEXT_SHARD %llu\nRINGS %llu\nCHECKSUM %llu\n",
+                       st.n, st.elem, st.depth, st.shards, st.next_shard, st.rings, st.checksum);
+    std::string out(body, static_cast<size_t>(len));
+    snprintf(body, sizeof(body), "HASH %llu\n", fnv1a(out.data(), out.size()));
+    return out + body;
+}
+
+// --- Atomic File I/O ---
+
+// Writes <path>.tmp, flushes it to disk and renames it over <path>.
+inline bool save_checkpoint(const char* path, const CheckpointState& st) {
+    const std::string text = format_checkpoint(st);
+    const std::string tmp = std::string(path) + ".tmp";
+#ifdef _WIN32
+    FILE* f = fopen(tmp.c_str(), "wb");
+    if (f == NULL) return false;
+    bool ok = fwrite(text.data(), 1, text.size(), f) == text.size() && fflush(f) == 0;
+    ok = (fclose(f) == 0) && ok;
+    return ok && MoveFileExA(tmp.c_str(), path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+    int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    bool ok = write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()) && fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    return ok && rename(tmp.c_str(), path) == 0;
+#endif
+}
+
+// Reads and verifies a checkpoint; false if missing, truncated or corrupt.
+inline bool load_checkpoint(const char* path, CheckpointState& st) {
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) return false;
+    char buf[512];
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = '\0';
+
+    const char* hash_line = std::strstr(buf, "HASH ");
+    if (hash_line == NULL) return false;
+    unsigned long long hash = 0;
+    if (sscanf(hash_line, "HASH %llu", &hash) != 1) return false;
+    if (hash != fnv1a(buf, static_cast<size_t>(hash_line - buf))) return false;
+
+    std::memset(&st, 0, sizeof(st));
+    int version = 0;
+    int fields = sscanf(buf,
+                        "RCPA_CHECKPOINT %d\nN %d\nELEMENT_TYPE %15s\nDEPTH %d\nSHARDS %llu\n"
+                        "NEXT_SHARD %llu\nRINGS %llu\nCHECKSUM %llu\n",
+                        &version, &st.n, st.elem, &st.depth, &st.shards, &st.next_shard, &st.rings,
+                        &st.checksum);
+    return fields == 8 && version == 1 && st.depth >= 0 && st.depth <= st.n - 3 &&
+           st.shards == shard_count(st.depth) && st.next_shard <= st.shards;
+}
+
+// --- Stop Signals ---
+
+inline volatile std::sig_atomic_t& stop_flag() {
+    static volatile std::sig_atomic_t flag = 0;
+    return flag;
+}
+
+inline void on_stop_signal(int) { stop_flag() = 1; }
+
+// SIGTERM / SIGINT request a checkpoint at the next shard boundary.
+inline void install_stop_signals() {
+    std::signal(SIGTERM, on_stop_signal);
+    std::signal(SIGINT, on_stop_signal);
+}
+
+inline bool stop_requested() { return stop_flag() != 0; }
+
+// --- Checkpointed Driver ---
+
+// Visits the shards [st.next_shard, st.shards), saving after every `every`
+// ring blocks and on a stop signal. The visitor accumulates into st.rings /
+// st.checksum (e.g. through a pointer to st), so they are saved with the
+// position. Returns true when the enumeration is complete; false after a
+// stop signal (state saved) or a failed write.
+template <class Gen, class Visitor>
+bool run_checkpointed(Gen& gen, Visitor& visit, CheckpointState& st, const char* path,
+                      unsigned long long every) {
+    const unsigned long long blocks_per_shard = factorial(st.n - 2) / st.shards;
+    unsigned long long since_save = 0;
+    while (st.next_shard < st.shards) {
+        gen.for_each_ring_in_shard(st.depth, st.next_shard, visit);
+        st.next_shard++;
+        since_save += blocks_per_shard;
+        if (stop_requested()) {
+            if (!save_checkpoint(path, st)) fprintf(stderr, "Error: cannot write checkpoint %s.\n", path);
+            return false;
+        }
+        if (since_save >= every) {
+            if (!save_checkpoint(path, st)) {
+                fprintf(stderr, "Error: cannot write checkpoint %s.\n", path);
+                return false;
+            }
+            since_save = 0;
+        }
+    }
+    return save_checkpoint(path, st);
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_CHECKPOINT_HPP
@@ -0,0 +1,418 @@
+/**
+ * @file    rcpa_coverage.hpp
+ * @brief   Exactly-once coverage check for permutation generators.
+ * @author  YUSHENG-HU
+ * @details
+ * A checksum such as sum j*D[j] cannot tell a generator that emits every
+ * permutation once from one that repeats some and skips others. Here every
+ * emitted permutation sets its own bit in an N!-bit bitmap; the run is
+ * correct iff N! permutations were visited and none found its bit set.
+ *
+ * Index. A permutation w of 0..N-1 is identified by the position p of N-1
+ * and the cyclic order of the other symbols after it:
+ *
+ *   class(w) = Lehmer rank of w[p+1], ..., w[p+N-1] (mod N)   in [0, (N-1)!)
+ *   index(w) = class(w) * N + p
+ *
+ * The N windows of a ring state are rotations of one sequence: they share
+ * the class and cover p = 0..N-1. A ring visitor therefore checks that the
+ * ring really is one (ring[0..N-1] a permutation, ring[N..2N-2] a copy of
+ * ring[0..N-2]), computes one Lehmer rank (all digits in one pass of SSE2
+ * byte compares) and sets N adjacent bits with one atomic fetch_or; a
+ * per-permutation visitor checks and ranks every call. A malformed ring or
+ * permutation marks nothing, so what it stood for shows up as missing.
+ *
+ * Bitmap. ShardedCoverage splits the classes into contiguous shards, one
+ * CoverageBitmap each, allocated and zeroed by a thread per shard so the
+ * pages are spread before marking starts. fetch_or returns the old word, so
+ * every duplicate is seen by exactly one marker. N = 13 needs 779 MB.
+ *
+ *   rcpa::ShardedCoverage seen(n);
+ *   rcpa::RingCoverage<T> visit(&seen);        // one copy per thread
+ *   gen.for_each_ring(visit);  visit.finish();
+ *   rcpa::CoverageResult r = seen.result(visit.visited, visit.duplicates);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_COVERAGE_HPP
+#define RCPA_COVERAGE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+const int COVERAGE_MAX_N = 14;  // 14! bits = 10.9 GB
+
+// Bits set in a 16-bit mask (SWAR: no libgcc call without -mpopcnt).
+inline int popcount16(unsigned x) {
+    x = x - ((x >> 1) & 0x5555u);
+    x = (x & 0x3333u) + ((x >> 2) & 0x3333u);
+    x = (x + (x >> 4)) & 0x0F0Fu;
+    return static_cast<int>((x + (x >> 8)) & 0x1Fu);
+}
+
+// --- Lehmer Rank ---
+
+#if defined(__SSE2__)
+namespace detail {
+
+// digits[t] += #{k in 1..K : v[t+k] > v[t]}; bytes shifted in are 0.
+template <int K>
+struct LehmerShifts {
+    static RCPA_INLINE __m128i add(__m128i digits, __m128i v) {
+        digits = _mm_sub_epi8(digits, _mm_cmpgt_epi8(_mm_srli_si128(v, K), v));
+        return LehmerShifts<K - 1>::add(digits, v);
+    }
+};
+
+template <>
+struct LehmerShifts<0> {
+    static RCPA_INLINE __m128i add(__m128i digits, __m128i) { return digits; }
+};
+
+}  // namespace detail
+#endif
+
+// Lexicographic rank of s[0..m-1], a permutation of 0..m-1 (m <= 16).
+// Digit t counts the later symbols smaller than s[t]. With SSE2 all digits
+// come from 15 shifted byte compares at once: the symbols are stored as
+// 0x7F - s, so "later and smaller" becomes "later and greater" and both the
+// padding and the shifted-in bytes (0) never count.
+template <typename T>
+inline unsigned long long lehmer_rank(const T* s, int m) {
+    static const unsigned long long fact[16] = {
+        1ull, 1ull, 2ull, 6ull, 24ull, 120ull, 720ull, 5040ull, 40320ull, 362880ull,
+        3628800ull, 39916800ull, 479001600ull, 6227020800ull, 87178291200ull, 1307674368000ull
+    };
+    unsigned long long rank = 0;
+#if defined(__SSE2__)
+    alignas(16) uint8_t bytes[16] = { 0 };
+    for (int t = 0; t < m; t++) bytes[t] = static_cast<uint8_t>(0x7F - static_cast<int>(s[t]));
+    const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(bytes));
+    _mm_store_si128(reinterpret_cast<__m128i*>(bytes), detail::LehmerShifts<15>::add(_mm_setzero_si128(), v));
+    for (int t = 0; t < m - 1; t++) rank += bytes[t] * fact[m - 1 - t];
+#else
+    unsigned unused = (1u << m) - 1;
+    for (int t = 0; t < m - 1; t++) {
+        const unsigned bit = 1u << static_cast<unsigned>(s[t]);
+        rank += static_cast<unsigned long long>(popcount16(unused & (bit - 1))) * fact[m - 1 - t];
+        unused &= ~bit;
+    }
+#endif
+    return rank;
+}
+
+// --- Rotation Index ---
+
+// True iff w[0..n-1] is a permutation of 0..n-1: every symbol < n, all n seen.
+template <typename T>
+inline bool is_permutation(const T* w, int n) {
+    unsigned present = 0;
+    for (int t = 0; t < n; t++) {
+        const unsigned v = static_cast<unsigned>(w[t]);
+        if (v >= static_cast<unsigned>(n)) return false;
+        present |= 1u << v;
+    }
+    return present == (1u << n) - 1;
+}
+
+// class(w) of a permutation w of 0..n-1 (see is_permutation()); p receives
+// the position of n-1.
+template <typename T>
+inline unsigned long long rotation_class(const T* w, int n, int& p) {
+    p = 0;
+    while (static_cast<int>(w[p]) != n - 1) p++;
+    T after[16];
+    for (int t = 0; t < n - 1; t++) {
+        int q = p + 1 + t;
+        if (q >= n) q -= n;
+        after[t] = w[q];
+    }
+    return lehmer_rank(after, n - 1);
+}
+
+template <typename T>
+inline unsigned long long rotation_index(const T* w, int n) {
+    int p;
+    const unsigned long long cls = rotation_class(w, n, p);
+    return cls * static_cast<unsigned long long>(n) + static_cast<unsigned long long>(p);
+}
+
+// Inverse of rotation_index().
+inline void rotation_unindex(unsigned long long index, int n, int* perm) {
+    const int p = static_cast<int>(index % static_cast<unsigned long long>(n));
+    unsigned long long rank = index / static_cast<unsigned long long>(n);
+    int digits[16];
+    for (int t = n - 2; t >= 0; t--) {
+        const unsigned long long radix = static_cast<unsigned long long>(n - 1 - t);
+        digits[t] = static_cast<int>(rank % radix);
+        rank /= radix;
+    }
+    unsigned unused = (1u << (n - 1)) - 1;
+    perm[p] = n - 1;
+    for (int t = 0; t < n - 1; t++) {
+        unsigned m = unused;
+        for (int d = 0; d < digits[t]; d++) m &= m - 1;
+        const int s = __builtin_ctz(m);
+        unused &= ~(1u << s);
+        perm[(p + 1 + t) % n] = s;
+    }
+}
+
+// --- Atomic Bitmap ---
+
+class CoverageBitmap {
+public:
+    explicit CoverageBitmap(unsigned long long bits)
+        : bits_(bits), words_((bits + 63) / 64), data_(new std::atomic<uint64_t>[(bits + 63) / 64]) {
+        for (unsigned long long w = 0; w < words_; w++) data_[w].store(0, std::memory_order_relaxed);
+    }
+
+    // Sets bit `i`; false if it was already set.
+    bool mark(unsigned long long i) {
+        const uint64_t bit = 1ull << (i & 63);
+        return (data_[i >> 6].fetch_or(bit, std::memory_order_relaxed) & bit) == 0;
+    }
+
+    // Sets the bits first + k for every bit k of `mask` (count <= 32 bits);
+    // returns which of them were already set, in the same layout.
+    uint64_t mark_bits(unsigned long long first, uint64_t mask, int count) {
+        const unsigned long long w = first >> 6;
+        const int off = static_cast<int>(first & 63);
+        uint64_t old = data_[w].fetch_or(mask << off, std::memory_order_relaxed) >> off;
+        if (off + count > 64 && (mask >> (64 - off)) != 0) {
+            old |= data_[w + 1].fetch_or(mask >> (64 - off), std::memory_order_relaxed) << (64 - off);
+        }
+        return old & mask;
+    }
+
+    void prefetch(unsigned long long i) const { __builtin_prefetch(&data_[i >> 6], 1); }
+
+    bool test(unsigned long long i) const {
+        return (data_[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+    }
+
+    unsigned long long size() const { return bits_; }
+
+    // Set bits; call once the markers are done.
+    unsigned long long count() const {
+        unsigned long long total = 0;
+        for (unsigned long long w = 0; w < words_; w++) {
+            total += static_cast<unsigned long long>(__builtin_popcountll(data_[w].load(std::memory_order_relaxed)));
+        }
+        return total;
+    }
+
+    // The first `limit` clear bits.
+    std::vector<unsigned long long> missing(size_t limit) const {
+        std::vector<unsigned long long> out;
+        for (unsigned long long w = 0; w < words_ && out.size() < limit; w++) {
+            uint64_t clear = ~data_[w].load(std::memory_order_relaxed);
+            while (clear != 0 && out.size() < limit) {
+                const unsigned long long i = w * 64 + static_cast<unsigned long long>(__builtin_ctzll(clear));
+                if (i >= bits_) break;
+                out.push_back(i);
+                clear &= clear - 1;
+            }
+        }
+        return out;
+    }
+
+private:
+    unsigned long long bits_;
+    unsigned long long words_;
+    std::unique_ptr<std::atomic<uint64_t>[]> data_;
+};
+
+// --- Sharded Coverage ---
+
+struct CoverageResult {
+    unsigned long long expected;    // N!
+    unsigned long long visited;     // permutations seen by the visitors
+    unsigned long long duplicates;  // visits that found their bit set
+    unsigned long long covered;     // distinct permutations
+    unsigned long long missing;     // expected - covered
+    std::vector<unsigned long long> first_missing;  // rotation indices
+
+    bool pass() const { return visited == expected && duplicates == 0 && missing == 0; }
+};
+
+class ShardedCoverage {
+public:
+    // shards == 0: one per hardware thread.
+    explicit ShardedCoverage(int n, unsigned shards = 0) : n_(n), classes_(factorial(n - 1)) {
+        if (shards == 0) shards = std::thread::hardware_concurrency();
+        if (shards == 0) shards = 1;
+        // Power-of-two shard size: the shard of a class is a shift.
+        shift_ = 0;
+        while ((1ull << shift_) * shards < classes_) shift_++;
+        per_shard_ = 1ull << shift_;
+        shards = static_cast<unsigned>((classes_ + per_shard_ - 1) / per_shard_);
+        shards_.resize(shards);
+        std::vector<std::thread> init;
+        for (unsigned s = 0; s < shards; s++) init.push_back(std::thread(ShardInit(this, s)));
+        for (size_t s = 0; s < init.size(); s++) init[s].join();
+    }
+
+    int n() const { return n_; }
+    unsigned long long classes() const { return classes_; }
+    unsigned shards() const { return static_cast<unsigned>(shards_.size()); }
+
+    // Marks the permutations of class `cls` selected by `mask` (bit p: N-1
+    // at position p); returns the bits of `mask` that were already set.
+    RCPA_INLINE uint64_t mark_class(unsigned long long cls, uint64_t mask) {
+        const unsigned long long first = (cls & (per_shard_ - 1)) * static_cast<unsigned long long>(n_);
+        return shards_[cls >> shift_]->mark_bits(first, mask, n_);
+    }
+
+    RCPA_INLINE void prefetch_class(unsigned long long cls) const {
+        shards_[cls >> shift_]->prefetch((cls & (per_shard_ - 1)) * static_cast<unsigned long long>(n_));
+    }
+
+    // Call once every visitor is done.
+    CoverageResult result(unsigned long long visited, unsigned long long duplicates, size_t report_limit = 8) const {
+        CoverageResult r;
+        r.expected = classes_ * static_cast<unsigned long long>(n_);
+        r.visited = visited;
+        r.duplicates = duplicates;
+        r.covered = 0;
+        for (size_t s = 0; s < shards_.size(); s++) {
+            r.covered += shards_[s]->count();
+            std::vector<unsigned long long> miss = shards_[s]->missing(report_limit - r.first_missing.size());
+            for (size_t k = 0; k < miss.size(); k++) {
+                r.first_missing.push_back(per_shard_ * s * static_cast<unsigned long long>(n_) + miss[k]);
+            }
+        }
+        r.missing = r.expected - r.covered;
+        return r;
+    }
+
+private:
+    // Allocates and zeroes one shard on the calling thread.
+    struct ShardInit {
+        ShardedCoverage* self;
+        unsigned s;
+
+        ShardInit(ShardedCoverage* c, unsigned shard) : self(c), s(shard) {}
+
+        void operator()() const {
+            const unsigned long long first = self->per_shard_ * s;
+            unsigned long long last = first + self->per_shard_;
+            if (last > self->classes_) last = self->classes_;
+            self->shards_[s].reset(new CoverageBitmap((last - first) * static_cast<unsigned long long>(self->n_)));
+        }
+    };
+
+    int n_;
+    unsigned long long classes_;
+    int shift_;
+    unsigned long long per_shard_;  // 1 << shift_
+    std::vector<std::unique_ptr<CoverageBitmap> > shards_;
+};
+
+// --- Visitors ---
+
+// for_each_ring visitor over the N windows ring + 0 .. ring + N-1. Copies
+// share the bitmap and count their own visits; call finish() on every copy
+// once its generator is done.
+//
+// Consecutive ring states land in unrelated parts of the bitmap, so a class
+// is marked DEPTH ring states after its word was prefetched and the misses
+// overlap instead of stalling the generator one by one.
+template <typename T>
+struct RingCoverage {
+    static const unsigned DEPTH = 8;
+
+    ShardedCoverage* seen;
+    unsigned long long visited;
+    unsigned long long duplicates;
+    unsigned long long malformed;  // ring states whose windows are not N rotations
+    unsigned long long queued;
+    unsigned long long queue[DEPTH];
+
+    explicit RingCoverage(ShardedCoverage* s) : seen(s), visited(0), duplicates(0), malformed(0), queued(0) {}
+
+    RCPA_INLINE void operator()(const T* ring) {
+        const int n = seen->n();
+        visited += static_cast<unsigned long long>(n);
+        if (!is_ring(ring, n)) {
+            malformed++;
+            return;
+        }
+        int p = 0;
+        while (static_cast<int>(ring[p]) != n - 1) p++;
+        // ring[p+1 .. p+N-1] is the cyclic order after N-1, unwrapped
+        // (the ring row holds 2N-1 valid entries).
+        const unsigned long long cls = lehmer_rank(ring + p + 1, n - 1);
+        seen->prefetch_class(cls);
+        unsigned long long& slot = queue[queued & (DEPTH - 1)];
+        if (queued >= DEPTH) mark(slot);
+        slot = cls;
+        queued++;
+    }
+
+    // Marks the classes still queued.
+    void finish() {
+        const unsigned long long first = queued > DEPTH ? queued - DEPTH : 0;
+        for (unsigned long long k = first; k < queued; k++) mark(queue[k & (DEPTH - 1)]);
+        queued = 0;
+    }
+
+private:
+    // The windows ring + h are the N rotations of ring[0..N-1] iff that is a
+    // permutation of 0..N-1 and ring[N+h] == ring[h] for h < N-1.
+    static RCPA_INLINE bool is_ring(const T* ring, int n) {
+        if (!is_permutation(ring, n)) return false;
+        for (int h = 0; h < n - 1; h++) {
+            if (ring[n + h] != ring[h]) return false;
+        }
+        return true;
+    }
+
+    // Window h has N-1 at position p - h (mod N): all N bits of the class.
+    RCPA_INLINE void mark(unsigned long long cls) {
+        const uint64_t old = seen->mark_class(cls, (1ull << seen->n()) - 1);
+        if (old != 0) duplicates += static_cast<unsigned long long>(__builtin_popcountll(old));
+    }
+};
+
+// Visitor for one permutation per call.
+template <typename T>
+struct PermCoverage {
+    ShardedCoverage* seen;
+    unsigned long long visited;
+    unsigned long long duplicates;
+    unsigned long long malformed;  // calls whose input is not a permutation of 0..N-1
+
+    explicit PermCoverage(ShardedCoverage* s) : seen(s), visited(0), duplicates(0), malformed(0) {}
+
+    RCPA_INLINE void operator()(const T* perm) {
+        const int n = seen->n();
+        if (!is_permutation(perm, n)) {
+            malformed++;
+            visited++;
+            return;
+        }
+        int p;
+        const unsigned long long cls = rotation_class(perm, n, p);
+        if (seen->mark_class(cls, 1ull << p) != 0) duplicates++;
+        visited++;
+    }
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_COVERAGE_HPP
@@ -0,0 +1,191 @@
+/**
+ * @file rcpa_coverage_test.cpp
+ * @brief Negative controls for the exactly-once check of rcpa_coverage.hpp
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Feeds the RCPA ring states of one N through RingCoverage, unchanged and
+ * with one ring state corrupted in each of the ways a broken ring or mirror
+ * update would show up, then does the same for the per-permutation stream
+ * through PermCoverage, and prints PASS/FAIL per case. The unchanged runs
+ * must PASS and every corrupted run must FAIL; the program exits with
+ * status 1 otherwise.
+ *
+ * Build: g++ -O2 -std=c++17 cpp/rcpa_coverage_test.cpp -o rcpa_coverage_test -pthread
+ * Usage: ./rcpa_coverage_test [n]   (default 8)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+#include "rcpa_coverage.hpp"
+
+enum Corruption {
+    NONE,          // generator output as is
+    ZERO_HEAD,     // ring[0..N-2] = 0
+    MIRROR,        // ring[N] != ring[0]: windows are not rotations
+    SWAP_WINDOW,   // two symbols of the last window exchanged, mirror kept
+    REPEAT_RING    // one ring state visited twice, its successor never
+};
+
+const char* corruption_name(Corruption c) {
+    switch (c) {
+        case NONE: return "none";
+        case ZERO_HEAD: return "zero_head";
+        case MIRROR: return "mirror";
+        case SWAP_WINDOW: return "swap_window";
+        default: return "repeat_ring";
+    }
+}
+
+// Copies each ring state (2N-1 entries) and corrupts the `target`-th one.
+struct Corrupter {
+    rcpa::RingCoverage<uint8_t>* cover;
+    int n;
+    Corruption how;
+    unsigned long long target;
+    unsigned long long index;
+    uint8_t row[2 * rcpa::COVERAGE_MAX_N];
+    uint8_t previous[2 * rcpa::COVERAGE_MAX_N];
+
+    void operator()(const uint8_t* ring) {
+        const int width = 2 * n - 1;
+        std::memcpy(row, ring, width);
+        if (index == target) {
+            switch (how) {
+                case ZERO_HEAD:
+                    std::memset(row, 0, n - 1);
+                    break;
+                case MIRROR:
+                    row[n] = row[1];
+                    break;
+                case SWAP_WINDOW: {
+                    const uint8_t t = row[n - 1];
+                    row[n - 1] = row[n - 2];
+                    row[n - 2] = t;
+                    for (int h = 0; h < n - 1; h++) row[n + h] = row[h];
+                    break;
+                }
+                case REPEAT_RING:
+                    std::memcpy(row, previous, width);
+                    break;
+                default:
+                    break;
+            }
+        }
+        std::memcpy(previous, ring, width);
+        index++;
+        (*cover)(row);
+    }
+};
+
+enum PermCorruption {
+    PERM_NONE,           // generator output as is
+    PERM_REPEAT_SYMBOL,  // one symbol replaced by its neighbour (3 1 2 0 -> 3 1 1 0)
+    PERM_OUT_OF_RANGE,   // N-1 replaced by N
+    PERM_REPEAT          // one permutation visited twice, its successor never
+};
+
+const char* perm_corruption_name(PermCorruption c) {
+    switch (c) {
+        case PERM_NONE: return "perm_none";
+        case PERM_REPEAT_SYMBOL: return "perm_repeat_symbol";
+        case PERM_OUT_OF_RANGE: return "perm_out_of_range";
+        default: return "perm_repeat";
+    }
+}
+
+// Copies each permutation (N entries) and corrupts the `target`-th one.
+struct PermCorrupter {
+    rcpa::PermCoverage<uint8_t>* cover;
+    int n;
+    PermCorruption how;
+    unsigned long long target;
+    unsigned long long index;
+    uint8_t row[rcpa::COVERAGE_MAX_N];
+    uint8_t previous[rcpa::COVERAGE_MAX_N];
+
+    void operator()(const uint8_t* perm) {
+        std::memcpy(row, perm, n);
+        if (index == target) {
+            switch (how) {
+                case PERM_REPEAT_SYMBOL:
+                    row[n - 2] = row[n - 3];
+                    break;
+                case PERM_OUT_OF_RANGE:
+                    for (int t = 0; t < n; t++) {
+                        if (row[t] == n - 1) row[t] = static_cast<uint8_t>(n);
+                    }
+                    break;
+                case PERM_REPEAT:
+                    std::memcpy(row, previous, n);
+                    break;
+                default:
+                    break;
+            }
+        }
+        std::memcpy(previous, perm, n);
+        index++;
+        (*cover)(row);
+    }
+};
+
+bool run_case(int n, Corruption how) {
+    rcpa::ShardedCoverage seen(n);
+    rcpa::RingCoverage<uint8_t> cover(&seen);
+    Corrupter visit;
+    visit.cover = &cover;
+    visit.n = n;
+    visit.how = how;
+    visit.target = 5;
+    visit.index = 0;
+    rcpa::DynamicGenerator<uint8_t> generator(n);
+    generator.for_each_ring(visit);
+    cover.finish();
+    const rcpa::CoverageResult r = seen.result(cover.visited, cover.duplicates);
+    printf("\nCASE_%s: %s (visited=%llu duplicates=%llu missing=%llu malformed=%llu)", corruption_name(how),
+           r.pass() ? "PASS" : "FAIL", r.visited, r.duplicates, r.missing, cover.malformed);
+    return r.pass();
+}
+
+bool run_perm_case(int n, PermCorruption how) {
+    rcpa::ShardedCoverage seen(n);
+    rcpa::PermCoverage<uint8_t> cover(&seen);
+    PermCorrupter visit;
+    visit.cover = &cover;
+    visit.n = n;
+    visit.how = how;
+    visit.target = 5;
+    visit.index = 0;
+    rcpa::DynamicGenerator<uint8_t> generator(n);
+    generator.for_each(visit);
+    const rcpa::CoverageResult r = seen.result(cover.visited, cover.duplicates);
+    printf("\nCASE_%s: %s (visited=%llu duplicates=%llu missing=%llu malformed=%llu)", perm_corruption_name(how),
+           r.pass() ? "PASS" : "FAIL", r.visited, r.duplicates, r.missing, cover.malformed);
+    return r.pass();
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const int n_val = argc > 1 ? std::atoi(argv[1]) : 8;
+    if (n_val <= 3 || n_val > 10) {
+        fprintf(stderr, "Error: n must be in [4, 10].\n");
+        return 1;
+    }
+
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_coverage_test");
+    printf("\nN_VALUE: %d", n_val);
+    bool ok = run_case(n_val, NONE);
+    const Corruption corrupted[] = { ZERO_HEAD, MIRROR, SWAP_WINDOW, REPEAT_RING };
+    for (Corruption how : corrupted) ok = !run_case(n_val, how) && ok;
+    ok = run_perm_case(n_val, PERM_NONE) && ok;
+    const PermCorruption perm_corrupted[] = { PERM_REPEAT_SYMBOL, PERM_OUT_OF_RANGE, PERM_REPEAT };
+    for (PermCorruption how : perm_corrupted) ok = !run_perm_case(n_val, how) && ok;
+    printf("\nVERIFY: %s", ok ? "PASS" : "FAIL");
+    printf("\nREPORT_END\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file    rcpa_dispatch.hpp
+ * @brief   Runtime CPU feature dispatch for the generator kernels.
+ * @author  YUSHENG-HU
+ * @details
+ * The benchmarks used to be built with -march=native, so a binary built on
+ * one host could crash on an older one. Instead, the kernel body is compiled
+ * once per ISA level and one variant is picked at startup:
+ *
+ *   scalar : build flags only (x86-64 baseline when built without -march)
+ *   sse4.2 : + SSE4.2, POPCNT                       (x86-64-v2)
+ *   avx2   : + AVX2, BMI1/2, FMA                    (x86-64-v3)
+ *   avx512 : + AVX-512 F/BW/DQ/VL/VBMI              (Ice Lake, Zen 4)
+ *
+ * A kernel is a functor with `template <class Tag> void operator()(Tag)`.
+ * rcpa::dispatch() calls it through a wrapper carrying the variant's target
+ * attribute plus `flatten`, so the functor and everything it inlines (the
+ * generator, the visitors) is compiled for that ISA. Tag::value names the
+ * variant, so a kernel can pick ISA-specific code such as the ring bursts
+ * of rcpa_simd.hpp (rcpa::BurstFor<Tag::value>).
+ *
+ * Usage:
+ *   rcpa::Isa isa;
+ *   if (!rcpa::resolve_isa(requested, isa)) return 1;  // NULL = best supported
+ *   rcpa::dispatch(isa, kernel);
+ *
+ * Without GCC/Clang on x86 only the scalar variant exists.
+ *
+ * Kernels that need N at compile time (unrolled bursts, constant buffer
+ * offsets) provide `template <int N> void run()` instead; dispatch_size()
+ * calls the instantiation for a runtime n through a table of MIN..MAX. The
+ * table calls are not flattened, so run<N>() does its own rcpa::dispatch():
+ *
+ *   if (!rcpa::dispatch_size<4, 20>(n, sized)) return 1;  // n out of range
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_DISPATCH_HPP
+#define RCPA_DISPATCH_HPP
+
+#include <cstdio>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RCPA_HAVE_DISPATCH 1
+#define RCPA_TARGET_SSE42 __attribute__((target("sse4.2,popcnt")))
+#define RCPA_TARGET_AVX2 __attribute__((target("avx2,bmi,bmi2,fma,popcnt")))
+#define RCPA_TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx512vbmi,avx2,bmi,bmi2,fma,popcnt")))
+#define RCPA_FLATTEN __attribute__((flatten))
+#else
+#define RCPA_HAVE_DISPATCH 0
+#define RCPA_TARGET_SSE42
+#define RCPA_TARGET_AVX2
+#define RCPA_TARGET_AVX512
+#define RCPA_FLATTEN
+#endif
+
+namespace rcpa {
+
+enum class Isa { Scalar = 0, Sse42 = 1, Avx2 = 2, Avx512 = 3 };
+
+const int ISA_COUNT = 4;
+
+// Widest variant the build flags alone enable (for code that is not dispatched).
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__) && defined(__AVX512DQ__) && defined(__AVX512VL__)
+const Isa BUILD_ISA = Isa::Avx512;
+#elif defined(__AVX2__) && defined(__BMI2__) && defined(__FMA__)
+const Isa BUILD_ISA = Isa::Avx2;
+#elif defined(__SSE4_2__) && defined(__POPCNT__)
+const Isa BUILD_ISA = Isa::Sse42;
+#else
+const Isa BUILD_ISA = Isa::Scalar;
+#endif
+
+template <Isa I>
+struct IsaTag {
+    static const Isa value = I;
+};
+
+inline const char* isa_name(Isa isa) {
+    switch (isa) {
+    case Isa::Sse42: return "sse4.2";
+    case Isa::Avx2: return "avx2";
+    case Isa::Avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+inline bool parse_isa(const char* name, Isa& isa) {
+    for (int i = 0; i < ISA_COUNT; i++) {
+        if (std::strcmp(name, isa_name(static_cast<Isa>(i))) == 0) {
+            isa = static_cast<Isa>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- CPU Feature Detection ---
+
+inline bool cpu_supports(Isa isa) {
+#if RCPA_HAVE_DISPATCH
+    __builtin_cpu_init();
+    switch (isa) {
+    case Isa::Avx512:
+        if (!__builtin_cpu_supports("avx512f") || !__builtin_cpu_supports("avx512bw") ||
+            !__builtin_cpu_supports("avx512dq") || !__builtin_cpu_supports("avx512vl") ||
+            !__builtin_cpu_supports("avx512vbmi"))
+            return false;
+        // fall through
+    case Isa::Avx2:
+        if (!__builtin_cpu_supports("avx2") || !__builtin_cpu_supports("bmi") ||
+            !__builtin_cpu_supports("bmi2") || !__builtin_cpu_supports("fma"))
+            return false;
+        // fall through
+    case Isa::Sse42:
+        return __builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt");
+    default:
+        return true;
+    }
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+inline Isa detect_isa() {
+    for (int i = ISA_COUNT - 1; i > 0; i--) {
+        if (cpu_supports(static_cast<Isa>(i))) return static_cast<Isa>(i);
+    }
+    return Isa::Scalar;
+}
+
+// Picks the variant to run: `requested` (an --isa= value) if given, else the
+// best one this CPU supports. Prints the reason and returns false for unknown
+// names or variants the CPU cannot run.
+inline bool resolve_isa(const char* requested, Isa& isa) {
+    if (requested == NULL) {
+        isa = detect_isa();
+        return true;
+    }
+    if (!parse_isa(requested, isa)) {
+        fprintf(stderr, "Error: unknown ISA '%s' (scalar|sse4.2|avx2|avx512).\n", requested);
+        return false;
+    }
+    if (!cpu_supports(isa)) {
+        fprintf(stderr, "Error: this CPU does not support the %s variant.\n", requested);
+        return false;
+    }
+    return true;
+}
+
+// --- Dispatch ---
+
+namespace detail {
+
+template <class Fn>
+RCPA_FLATTEN void run_scalar(Fn& fn) { fn(IsaTag<Isa::Scalar>()); }
+
+template <class Fn>
+RCPA_FLATTEN RCPA_TARGET_SSE42 void run_sse42(Fn& fn) { fn(IsaTag<Isa::Sse42>()); }
+
+template <class Fn>
+RCPA_FLATTEN RCPA_TARGET_AVX2 void run_avx2(Fn& fn) { fn(IsaTag<Isa::Avx2>()); }
+
+template <class Fn>
+RCPA_FLATTEN RCPA_TARGET_AVX512 void run_avx512(Fn& fn) { fn(IsaTag<Isa::Avx512>()); }
+
+template <int N, class Fn>
+void run_size(Fn& fn) { fn.template run<N>(); }
+
+// table[k] = run_size<N + k> for N + k in [N, MAX].
+template <int N, int MAX, class Fn>
+struct SizeTableFill {
+    static void fill(void (**table)(Fn&)) {
+        table[0] = &run_size<N, Fn>;
+        SizeTableFill<N + 1, MAX, Fn>::fill(table + 1);
+    }
+};
+
+template <int MAX, class Fn>
+struct SizeTableFill<MAX, MAX, Fn> {
+    static void fill(void (**table)(Fn&)) { table[0] = &run_size<MAX, Fn>; }
+};
+
+template <int MIN, int MAX, class Fn>
+struct SizeTable {
+    void (*run[MAX - MIN + 1])(Fn&);
+
+    SizeTable() { SizeTableFill<MIN, MAX, Fn>::fill(run); }
+};
+
+}  // namespace detail
+
+template <class Fn>
+void dispatch(Isa isa, Fn& fn) {
+#if RCPA_HAVE_DISPATCH
+    switch (isa) {
+    case Isa::Sse42: detail::run_sse42(fn); return;
+    case Isa::Avx2: detail::run_avx2(fn); return;
+    case Isa::Avx512: detail::run_avx512(fn); return;
+    default: break;
+    }
+#else
+    (void)isa;
+#endif
+    detail::run_scalar(fn);
+}
+
+// Calls fn.run<n>() for MIN <= n <= MAX; false (nothing run) otherwise.
+template <int MIN, int MAX, class Fn>
+bool dispatch_size(int n, Fn& fn) {
+    static_assert(MIN <= MAX, "empty size range");
+    if (n < MIN || n > MAX) return false;
+    static const detail::SizeTable<MIN, MAX, Fn> table;
+    table.run[n - MIN](fn);
+    return true;
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_DISPATCH_HPP
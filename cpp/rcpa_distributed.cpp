@@ -0,0 +1,182 @@
+/**
+ * @file rcpa_distributed.cpp
+ * @brief Multi-process RCPA enumeration with a local coordinator
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * One enumeration spread over worker processes (rcpa_distributed.hpp). The
+ * coordinator leases C-prefix shards over a Unix socket, re-issues the lease
+ * of any worker that dies, and merges the per-shard ring checksums and, with
+ * --objective, the min/max open-path cost of rcpa_objective.hpp into one
+ * REPORT block. The checksum equals the one of rcpa_parallel.cpp.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_distributed.cpp -o rcpa_distributed
+ * Usage: ./rcpa_distributed coordinator <n> --socket=PATH [--workers=K] [--depth=D] [--objective]
+ *        ./rcpa_distributed worker --socket=PATH
+ *   --workers   : worker processes forked by the coordinator (default 0:
+ *                 only workers started by hand)
+ *   --depth     : shard depth, (depth + 1)! leases (default: ~64 per core)
+ *   --objective : also score the open path over a seeded distance matrix
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "rcpa_distributed.hpp"
+#include "rcpa_objective.hpp"
+#include "rcpa_parallel.hpp"
+
+typedef long long Cost;
+
+// Same checksum as rcpa_parallel.cpp.
+struct RingChecksum {
+    int n;
+    unsigned long long sum;
+    unsigned long long rings;
+
+    void operator()(const uint8_t* ring) {
+        sum += static_cast<unsigned long long>(ring[0] * n + ring[n - 1]);
+        rings++;
+    }
+};
+
+// Symmetric distances in [1, 1000] from `seed` (as in rcpa_objective.cpp).
+std::vector<Cost> make_distances(int n, unsigned long long seed) {
+    std::vector<Cost> dist(static_cast<size_t>(n) * n, 0);
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n; b++) {
+            seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+            dist[a * n + b] = dist[b * n + a] = static_cast<Cost>((seed >> 33) % 1000 + 1);
+        }
+    }
+    return dist;
+}
+
+// One shard: RCPA indices [shard * N!/(depth+1)!, (shard + 1) * N!/(depth+1)!).
+struct ShardRunner {
+    rcpa::LeaseResult operator()(const rcpa::DistributedJob& job, unsigned long long shard) const {
+        rcpa::DynamicGenerator<uint8_t> generator(job.n);
+        rcpa::LeaseResult r;
+        if (job.objective) {
+            const std::vector<Cost> dist = make_distances(job.n, job.seed);
+            rcpa::PathCost<Cost> cost(job.n, dist.data());
+            rcpa::ObjectiveVisitor<rcpa::PathCost<Cost>, uint8_t> visit(job.n, cost, rcpa::ObjectiveOptions());
+            visit.seek(shard * (rcpa::factorial(job.n) / rcpa::shard_count(job.depth)));
+            RingChecksum sum = { job.n, 0, 0 };
+            generator.for_each_ring_in_shard(job.depth, shard, [&](const uint8_t* ring) {
+                sum(ring);
+                visit(ring);
+            });
+            rcpa::ObjectiveResult<Cost> o = visit.result();
+            r.rings = sum.rings;
+            r.checksum = sum.sum;
+            r.min_cost = o.min.cost;
+            r.min_index = o.min.index;
+            r.max_cost = o.max.cost;
+            r.max_index = o.max.index;
+        } else {
+            RingChecksum sum = { job.n, 0, 0 };
+            generator.for_each_ring_in_shard(job.depth, shard, sum);
+            r.rings = sum.rings;
+            r.checksum = sum.sum;
+        }
+        return r;
+    }
+};
+
+int usage(const char* prog) {
+    fprintf(stderr,
+            "Usage: %s coordinator <n> --socket=PATH [--workers=K] [--depth=D] [--objective]\n"
+            "       %s worker --socket=PATH\n",
+            prog, prog);
+    return 1;
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    if (argc < 2) return usage(argv[0]);
+    const bool coordinator = std::strcmp(argv[1], "coordinator") == 0;
+    if (!coordinator && std::strcmp(argv[1], "worker") != 0) return usage(argv[0]);
+
+    const char* socket_path = NULL;
+    const char* n_arg = NULL;
+    int depth = -1;
+    unsigned workers = 0;
+    bool objective = false;
+    for (int a = 2; a < argc; a++) {
+        if (std::strncmp(argv[a], "--socket=", 9) == 0) socket_path = argv[a] + 9;
+        else if (std::strncmp(argv[a], "--workers=", 10) == 0) workers = static_cast<unsigned>(std::atoi(argv[a] + 10));
+        else if (std::strncmp(argv[a], "--depth=", 8) == 0) depth = std::atoi(argv[a] + 8);
+        else if (std::strcmp(argv[a], "--objective") == 0) objective = true;
+        else if (n_arg == NULL) n_arg = argv[a];
+        else return usage(argv[0]);
+    }
+    if (socket_path == NULL) return usage(argv[0]);
+
+    if (!coordinator) {
+        if (!rcpa::run_worker(socket_path, ShardRunner())) {
+            fprintf(stderr, "Error: lost the coordinator at %s.\n", socket_path);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (n_arg == NULL) return usage(argv[0]);
+    int n_val = std::atoi(n_arg);
+    if (n_val <= 3 || n_val > 20) {
+        fprintf(stderr, "Error: n must be in 4..20 for the distributed run.\n");
+        return 1;
+    }
+    if (depth < 0) {
+        unsigned cores = std::thread::hardware_concurrency();
+        depth = rcpa::plan_shards(n_val, workers > cores ? workers : (cores ? cores : 1)).depth;
+    }
+    if (depth > n_val - 3) {
+        fprintf(stderr, "Error: depth must be in 0..%d.\n", n_val - 3);
+        return 1;
+    }
+
+    rcpa::DistributedJob job = { n_val, depth, objective ? 1 : 0, 0x9E3779B97F4A7C15ull };
+    rcpa::CoordinatorOptions opt;
+    opt.local_workers = workers;
+    rcpa::LeaseResult total;
+
+    auto start_point = std::chrono::high_resolution_clock::now();
+    if (!rcpa::run_coordinator(socket_path, job, opt, ShardRunner(), total)) {
+        fprintf(stderr, "Error: cannot serve %s.\n", socket_path);
+        return 1;
+    }
+    auto end_point = std::chrono::high_resolution_clock::now();
+    double duration = std::chrono::duration<double>(end_point - start_point).count();
+
+    const unsigned long long total_perms = rcpa::factorial(n_val);
+    if (total.rings * static_cast<unsigned long long>(n_val) != total_perms) {
+        fprintf(stderr, "Error: workers covered %llu of %llu permutations.\n",
+                total.rings * n_val, total_perms);
+        return 1;
+    }
+
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_distributed");
+    printf("\nN_VALUE: %d", n_val);
+    printf("\nWORKERS: %u", workers);
+    printf("\nSHARD_DEPTH: %d", depth);
+    printf("\nLEASES: %llu", rcpa::shard_count(depth));
+    printf("\nEXECUTION_TIME: %lf", duration);
+    printf("\nSPEED: %.2f", (total_perms / duration) / 1e9);
+    printf("\nCHECKSUM: %llu", total.checksum);
+    if (objective) {
+        printf("\nMIN_COST: %lld", total.min_cost);
+        printf("\nMIN_INDEX: %llu", total.min_index);
+        printf("\nMAX_COST: %lld", total.max_cost);
+        printf("\nMAX_INDEX: %llu", total.max_index);
+    }
+    printf("\nREPORT_END\n");
+    return 0;
+}
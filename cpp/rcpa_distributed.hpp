@@ -0,0 +1,395 @@
+/**
+ * @file    rcpa_distributed.hpp
+ * @brief   Multi-process RCPA: a coordinator leasing C-prefix shards to workers.
+ * @author  YUSHENG-HU
+ * @details
+ * The shards of rcpa_parallel.hpp (fixed C[1..depth]) are independent, so
+ * they can as well be run by separate processes. A coordinator owns the
+ * shard table and hands out one shard per lease over a Unix stream socket.
+ * Workers are processes of the same binary, started locally by the
+ * coordinator or by hand (other hosts can reach the socket through
+ * `ssh -R remote.sock:local.sock`).
+ *
+ * Protocol (one text line per message):
+ *   worker      -> coordinator              coordinator -> worker
+ *   HELLO <pid>                             JOB <n> <depth> <objective> <seed>
+ *   NEXT                                    LEASE <shard> | DONE
+ *   RESULT <shard> <rings> <checksum>
+ *          <min_cost> <min_index> <max_cost> <max_index>
+ *
+ * A lease belongs to its connection. When a worker dies its socket closes
+ * and its lease returns to the queue, to be re-issued first. A shard is
+ * merged once, the first time its result arrives.
+ *
+ * POSIX only (sockets, poll, fork).
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_DISTRIBUTED_HPP
+#define RCPA_DISTRIBUTED_HPP
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+// --- Job / Results ---
+
+struct DistributedJob {
+    int n;
+    int depth;                // shards fix C[1..depth]: (depth + 1)! leases
+    int objective;            // 0 = checksum only, 1 = also min/max path cost
+    unsigned long long seed;  // seed of the objective's distance matrix
+};
+
+struct LeaseResult {
+    unsigned long long rings = 0;
+    unsigned long long checksum = 0;
+    long long min_cost = std::numeric_limits<long long>::max();
+    unsigned long long min_index = 0;
+    long long max_cost = std::numeric_limits<long long>::lowest();
+    unsigned long long max_index = 0;
+
+    // Ties keep the lower RCPA index, as in a single run.
+    void merge(const LeaseResult& r) {
+        rings += r.rings;
+        checksum += r.checksum;
+        if (r.min_cost < min_cost || (r.min_cost == min_cost && r.min_index < min_index)) {
+            min_cost = r.min_cost;
+            min_index = r.min_index;
+        }
+        if (r.max_cost > max_cost || (r.max_cost == max_cost && r.max_index < max_index)) {
+            max_cost = r.max_cost;
+            max_index = r.max_index;
+        }
+    }
+};
+
+// --- Lease Table ---
+
+class LeaseTable {
+public:
+    explicit LeaseTable(unsigned long long shards)
+        : state_(shards, FREE), owner_(shards, -1), next_(0), done_(0) {}
+
+    unsigned long long shards() const { return state_.size(); }
+    unsigned long long done() const { return done_; }
+    bool finished() const { return done_ == state_.size(); }
+
+    // Next free shard for `owner`: re-issued shards first, then fresh ones.
+    bool acquire(int owner, unsigned long long& shard) {
+        while (!requeued_.empty()) {
+            shard = requeued_.front();
+            requeued_.pop_front();
+            if (state_[shard] == FREE) return issue(owner, shard);
+        }
+        if (next_ < state_.size()) return issue(owner, shard = next_++);
+        return false;
+    }
+
+    // Every shard `owner` still holds goes back to the queue.
+    unsigned release(int owner) {
+        unsigned released = 0;
+        std::map<int, std::vector<unsigned long long> >::iterator it = held_.find(owner);
+        if (it == held_.end()) return 0;
+        for (size_t i = 0; i < it->second.size(); i++) {
+            const unsigned long long shard = it->second[i];
+            if (state_[shard] == ISSUED && owner_[shard] == owner) {
+                state_[shard] = FREE;
+                requeued_.push_back(shard);
+                released++;
+            }
+        }
+        held_.erase(it);
+        return released;
+    }
+
+    // True the first time a shard completes; duplicates and unknown shards
+    // are rejected.
+    bool complete(int owner, unsigned long long shard) {
+        if (shard >= state_.size() || state_[shard] == DONE) return false;
+        state_[shard] = DONE;
+        done_++;
+        std::vector<unsigned long long>& held = held_[owner];
+        for (size_t i = 0; i < held.size(); i++) {
+            if (held[i] == shard) {
+                held.erase(held.begin() + static_cast<long>(i));
+                break;
+            }
+        }
+        return true;
+    }
+
+private:
+    enum State : unsigned char { FREE, ISSUED, DONE };
+
+    bool issue(int owner, unsigned long long shard) {
+        state_[shard] = ISSUED;
+        owner_[shard] = owner;
+        held_[owner].push_back(shard);
+        return true;
+    }
+
+    std::vector<unsigned char> state_;
+    std::vector<int> owner_;
+    std::deque<unsigned long long> requeued_;
+    std::map<int, std::vector<unsigned long long> > held_;
+    unsigned long long next_;
+    unsigned long long done_;
+};
+
+// --- Line I/O ---
+
+inline bool send_line(int fd, const std::string& line) {
+    const std::string msg = line + "\n";
+    size_t sent = 0;
+    while (sent < msg.size()) {
+        ssize_t w = send(fd, msg.data() + sent, msg.size() - sent, MSG_NOSIGNAL);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        sent += static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// Buffered reader; read_some() appends what the socket has, next_line()
+// pops complete lines.
+class LineReader {
+public:
+    explicit LineReader(int fd = -1) : fd_(fd) {}
+
+    // false on EOF or error.
+    bool read_some() {
+        char chunk[4096];
+        for (;;) {
+            ssize_t r = recv(fd_, chunk, sizeof(chunk), 0);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) return false;
+            buf_.append(chunk, static_cast<size_t>(r));
+            return true;
+        }
+    }
+
+    bool next_line(std::string& line) {
+        size_t eol = buf_.find('\n');
+        if (eol == std::string::npos) return false;
+        line = buf_.substr(0, eol);
+        buf_.erase(0, eol + 1);
+        return true;
+    }
+
+    // Blocking: waits for one complete line.
+    bool read_line(std::string& line) {
+        while (!next_line(line)) {
+            if (!read_some()) return false;
+        }
+        return true;
+    }
+
+private:
+    int fd_;
+    std::string buf_;
+};
+
+inline bool make_address(const char* path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(addr.sun_path)) return false;
+    std::strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+    return true;
+}
+
+// --- Worker ---
+
+// Connects to the coordinator and runs leases until DONE. run_lease(job,
+// shard) returns the LeaseResult of one shard. Returns false if the
+// connection fails or drops.
+template <class RunLease>
+bool run_worker(const char* socket_path, RunLease&& run_lease) {
+    sockaddr_un addr;
+    if (!make_address(socket_path, addr)) return false;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return false;
+    if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    LineReader in(fd);
+    std::string line;
+    char msg[256];
+    DistributedJob job;
+    snprintf(msg, sizeof(msg), "HELLO %d", static_cast<int>(getpid()));
+    bool ok = send_line(fd, msg) && in.read_line(line) &&
+              sscanf(line.c_str(), "JOB %d %d %d %llu", &job.n, &job.depth, &job.objective, &job.seed) == 4;
+
+    while (ok) {
+        // The coordinator may already have sent DONE and closed, so a
+        // failed send is only an error if nothing is left to read.
+        send_line(fd, "NEXT");
+        if (!in.read_line(line)) {
+            ok = false;
+            break;
+        }
+        if (line == "DONE") break;
+        unsigned long long shard = 0;
+        if (sscanf(line.c_str(), "LEASE %llu", &shard) != 1) {
+            ok = false;
+            break;
+        }
+        const LeaseResult r = run_lease(job, shard);
+        snprintf(msg, sizeof(msg), "RESULT %llu %llu %llu %lld %llu %lld %llu", shard, r.rings, r.checksum,
+                 r.min_cost, r.min_index, r.max_cost, r.max_index);
+        ok = send_line(fd, msg);
+    }
+    close(fd);
+    return ok;
+}
+
+// --- Coordinator ---
+
+struct CoordinatorOptions {
+    unsigned local_workers = 0;  // worker processes to fork (and respawn on death)
+    bool verbose = true;         // lease re-issues on stderr
+};
+
+// Serves the shard table of `job` until every shard has a result, then
+// returns the merged result. Forked local workers call run_lease like
+// run_worker(). Returns false if the socket cannot be set up.
+template <class RunLease>
+bool run_coordinator(const char* socket_path, const DistributedJob& job, const CoordinatorOptions& opt,
+                     RunLease&& run_lease, LeaseResult& total) {
+    sockaddr_un addr;
+    if (!make_address(socket_path, addr)) return false;
+    unlink(socket_path);
+    int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) return false;
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listen_fd, 64) != 0) {
+        close(listen_fd);
+        return false;
+    }
+
+    LeaseTable table(shard_count(job.depth));
+    std::vector<pid_t> children;
+    unsigned spawned = 0;
+    std::fflush(stdout);
+    std::fflush(stderr);
+    for (; spawned < opt.local_workers; spawned++) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(listen_fd);
+            _exit(run_worker(socket_path, run_lease) ? 0 : 1);
+        }
+        if (pid > 0) children.push_back(pid);
+    }
+
+    struct Client {
+        LineReader in;
+        bool waiting;  // sent NEXT while every shard was leased
+    };
+    std::map<int, Client> clients;
+    char msg[256];
+
+    while (!table.finished()) {
+        std::vector<pollfd> fds(1);
+        fds[0].fd = listen_fd;
+        fds[0].events = POLLIN;
+        for (auto& entry : clients) {
+            pollfd p = { entry.first, POLLIN, 0 };
+            fds.push_back(p);
+        }
+        if (poll(fds.data(), fds.size(), 1000) < 0 && errno != EINTR) break;
+
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listen_fd, NULL, NULL);
+            if (fd >= 0) {
+                Client c = { LineReader(fd), false };
+                clients[fd] = c;
+            }
+        }
+        for (size_t i = 1; i < fds.size(); i++) {
+            if (fds[i].revents == 0) continue;
+            const int fd = fds[i].fd;
+            Client& c = clients[fd];
+            bool alive = c.in.read_some();
+            std::string line;
+            while (alive && c.in.next_line(line)) {
+                unsigned long long shard = 0;
+                LeaseResult r;
+                if (line.compare(0, 6, "HELLO ") == 0) {
+                    snprintf(msg, sizeof(msg), "JOB %d %d %d %llu", job.n, job.depth, job.objective, job.seed);
+                    alive = send_line(fd, msg);
+                } else if (line == "NEXT") {
+                    c.waiting = true;
+                } else if (sscanf(line.c_str(), "RESULT %llu %llu %llu %lld %llu %lld %llu", &shard, &r.rings,
+                                  &r.checksum, &r.min_cost, &r.min_index, &r.max_cost, &r.max_index) == 7) {
+                    if (table.complete(fd, shard)) total.merge(r);
+                } else {
+                    alive = false;
+                }
+            }
+            if (!alive) {
+                unsigned lost = table.release(fd);
+                if (lost && opt.verbose) fprintf(stderr, "Worker lost; re-issuing %u lease(s).\n", lost);
+                close(fd);
+                clients.erase(fd);
+            }
+        }
+
+        // Hand out leases to idle workers.
+        for (auto& entry : clients) {
+            unsigned long long shard;
+            if (!entry.second.waiting || !table.acquire(entry.first, shard)) continue;
+            entry.second.waiting = false;
+            snprintf(msg, sizeof(msg), "LEASE %llu", shard);
+            send_line(entry.first, msg);  // a dead peer shows up as EOF on the next poll
+        }
+
+        // Reap local workers and replace the ones that died with work left.
+        for (size_t k = 0; k < children.size(); k++) {
+            int status = 0;
+            if (children[k] <= 0 || waitpid(children[k], &status, WNOHANG) != children[k]) continue;
+            children[k] = -1;
+            if (table.finished()) continue;
+            pid_t pid = fork();
+            if (pid == 0) {
+                close(listen_fd);
+                _exit(run_worker(socket_path, run_lease) ? 0 : 1);
+            }
+            children[k] = pid;
+        }
+    }
+
+    // Workers finishing a lease send NEXT after RESULT; DONE answers it.
+    for (auto& entry : clients) {
+        send_line(entry.first, "DONE");
+        close(entry.first);
+    }
+    for (size_t k = 0; k < children.size(); k++) {
+        if (children[k] > 0) waitpid(children[k], NULL, 0);
+    }
+    close(listen_fd);
+    unlink(socket_path);
+    return table.finished();
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_DISTRIBUTED_HPP
@@ -0,0 +1,512 @@
+/**
+ * @file    rcpa_dump.hpp
+ * @brief   Streaming binary dump of permutations: double-buffered, io_uring / O_DIRECT / mmap.
+ * @author  YUSHENG-HU
+ * @details
+ * Materialises permutations as raw bytes, N bytes per permutation (values
+ * 0..N-1, no separators), in RCPA order. The ring visitor copies the N
+ * windows of each ring state into one of two large page-aligned buffers.
+ * When a buffer is full it is handed to the I/O backend and generation
+ * continues in the other one, so generation overlaps the write:
+ *
+ *   null  : buffers are discarded (generation + copy cost only)
+ *   write : a writer thread issues write(2) / pwrite(2)
+ *   uring : io_uring IORING_OP_WRITE submitted from the generating thread
+ *           (raw syscalls, no liburing); falls back to `write` if the kernel
+ *           refuses io_uring_setup
+ *   mmap  : the output file is sized up front and mapped; windows are
+ *           written in place and flushed with msync(MS_ASYNC)
+ *
+ * --direct opens regular files with O_DIRECT for write / uring: buffers and
+ * offsets are 4 KiB aligned, and the unaligned tail is written after
+ * clearing O_DIRECT. Pipes (path "-") work with write and uring.
+ *
+ * Usage:
+ *   rcpa::DumpWriter out;
+ *   out.open("perms.bin", rcpa::factorial(n) * n, opt);
+ *   rcpa::DumpVisitor visit = { &out, n };
+ *   gen.for_each_ring(visit);
+ *   out.close();
+ *
+ * Linux / POSIX only.
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_DUMP_HPP
+#define RCPA_DUMP_HPP
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define RCPA_HAVE_URING 1
+#endif
+#endif
+#ifndef RCPA_HAVE_URING
+#define RCPA_HAVE_URING 0
+#endif
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+enum class DumpBackend { Null = 0, Write = 1, Uring = 2, Mmap = 3 };
+
+const int DUMP_BACKEND_COUNT = 4;
+
+inline const char* dump_backend_name(DumpBackend b) {
+    switch (b) {
+    case DumpBackend::Null: return "null";
+    case DumpBackend::Uring: return "uring";
+    case DumpBackend::Mmap: return "mmap";
+    default: return "write";
+    }
+}
+
+inline bool parse_dump_backend(const char* name, DumpBackend& b) {
+    for (int i = 0; i < DUMP_BACKEND_COUNT; i++) {
+        if (std::strcmp(name, dump_backend_name(static_cast<DumpBackend>(i))) == 0) {
+            b = static_cast<DumpBackend>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+struct DumpOptions {
+    DumpBackend backend = DumpBackend::Write;
+    bool direct = false;                // O_DIRECT for write / uring on regular files
+    size_t buffer_bytes = 8u << 20;     // per buffer; a multiple of 4 KiB
+};
+
+#if RCPA_HAVE_URING
+// --- Minimal io_uring (raw syscalls) ---
+
+class Uring {
+public:
+    Uring() : fd_(-1) {}
+    ~Uring() { close(); }
+
+    bool setup(unsigned entries) {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &p));
+        if (fd_ < 0) return false;
+
+        sq_bytes_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_bytes_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single && cq_bytes_ > sq_bytes_) sq_bytes_ = cq_bytes_;
+        sq_ = mmap(NULL, sq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if (sq_ == MAP_FAILED) return fail();
+        cq_ = single ? sq_
+                     : mmap(NULL, cq_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+                            IORING_OFF_CQ_RING);
+        if (cq_ == MAP_FAILED) return fail();
+        sqes_bytes_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(
+            mmap(NULL, sqes_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+        if (sqes_ == MAP_FAILED) return fail();
+
+        char* sq = static_cast<char*>(sq_);
+        char* cq = static_cast<char*>(cq_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        single_ = single;
+        return true;
+    }
+
+    void close() {
+        if (fd_ < 0) return;
+        if (sqes_ != MAP_FAILED && sqes_ != NULL) munmap(sqes_, sqes_bytes_);
+        if (cq_ != MAP_FAILED && cq_ != NULL && !single_) munmap(cq_, cq_bytes_);
+        if (sq_ != MAP_FAILED && sq_ != NULL) munmap(sq_, sq_bytes_);
+        ::close(fd_);
+        fd_ = -1;
+    }
+
+    // Queues and submits one write; `tag` comes back with its completion.
+    bool write(int fd, const void* buf, unsigned len, unsigned long long off, unsigned long long tag) {
+        const unsigned tail = *sq_tail_;
+        const unsigned index = tail & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_WRITE;
+        sqe->fd = fd;
+        sqe->addr = reinterpret_cast<unsigned long long>(buf);
+        sqe->len = len;
+        sqe->off = off;
+        sqe->user_data = tag;
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        for (;;) {
+            long r = syscall(__NR_io_uring_enter, fd_, 1, 0, 0, NULL, 0);
+            if (r >= 0) return r == 1;
+            if (errno != EINTR) return false;
+        }
+    }
+
+    // Blocks for the next completion.
+    bool wait(unsigned long long& tag, int& res) {
+        for (;;) {
+            unsigned head = *cq_head_;
+            if (head != __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+                const io_uring_cqe* cqe = &cqes_[head & cq_mask_];
+                tag = cqe->user_data;
+                res = cqe->res;
+                __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            long r = syscall(__NR_io_uring_enter, fd_, 0, 1, IORING_ENTER_GETEVENTS, NULL, 0);
+            if (r < 0 && errno != EINTR) return false;
+        }
+    }
+
+private:
+    bool fail() {
+        close();
+        return false;
+    }
+
+    int fd_;
+    bool single_ = false;
+    void* sq_ = NULL;
+    void* cq_ = NULL;
+    io_uring_sqe* sqes_ = NULL;
+    size_t sq_bytes_ = 0, cq_bytes_ = 0, sqes_bytes_ = 0;
+    unsigned* sq_tail_ = NULL;
+    unsigned* sq_array_ = NULL;
+    unsigned sq_mask_ = 0;
+    unsigned* cq_head_ = NULL;
+    unsigned* cq_tail_ = NULL;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = NULL;
+};
+#endif
+
+// --- Double-Buffered Writer ---
+
+class DumpWriter {
+public:
+    static const size_t SLACK = 64 * 1024;  // one reserve() may run past the buffer end
+    static const size_t ALIGN = 4096;
+
+    DumpWriter() {}
+    ~DumpWriter() { close(); }
+
+    DumpBackend backend() const { return backend_; }
+    bool direct() const { return direct_; }  // output file opened with O_DIRECT
+    bool ok() const { return ok_; }
+    unsigned long long written() const { return file_off_; }
+
+    // path "-" is stdout. total_bytes is needed by mmap only.
+    bool open(const char* path, unsigned long long total_bytes, const DumpOptions& opt) {
+        close();
+        backend_ = opt.backend;
+        cap_ = (opt.buffer_bytes + ALIGN - 1) / ALIGN * ALIGN;
+        if (cap_ == 0) cap_ = ALIGN;
+        file_off_ = 0;
+        ok_ = true;
+        seekable_ = false;
+        direct_ = false;
+
+        if (backend_ != DumpBackend::Null) {
+            if (std::strcmp(path, "-") == 0) {
+                fd_ = 1;
+                own_fd_ = false;
+            } else {
+                int flags = O_CREAT | O_TRUNC | (backend_ == DumpBackend::Mmap ? O_RDWR : O_WRONLY);
+#ifdef O_DIRECT
+                if (opt.direct && backend_ != DumpBackend::Mmap) flags |= O_DIRECT;
+#endif
+                fd_ = ::open(path, flags, 0644);
+                own_fd_ = true;
+                if (fd_ < 0) return ok_ = false;
+            }
+            struct stat st;
+            seekable_ = fstat(fd_, &st) == 0 && S_ISREG(st.st_mode);
+#ifdef O_DIRECT
+            direct_ = opt.direct && seekable_ && backend_ != DumpBackend::Mmap;
+#endif
+        }
+
+        if (backend_ == DumpBackend::Mmap) {
+            if (!seekable_ || ftruncate(fd_, static_cast<off_t>(total_bytes)) != 0) return ok_ = false;
+            map_bytes_ = total_bytes ? total_bytes : 1;
+            void* p = mmap(NULL, map_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (p == MAP_FAILED) return ok_ = false;
+            madvise(p, map_bytes_, MADV_SEQUENTIAL);
+            map_ = static_cast<uint8_t*>(p);
+            cur_ = map_;
+            pos_ = 0;
+            return true;
+        }
+
+        for (int b = 0; b < 2; b++) {
+            buf_[b] = static_cast<uint8_t*>(std::aligned_alloc(ALIGN, cap_ + SLACK));
+            if (buf_[b] == NULL) return ok_ = false;
+            busy_[b] = false;
+        }
+        cur_b_ = 0;
+        cur_ = buf_[0];
+        pos_ = 0;
+
+#if RCPA_HAVE_URING
+        if (backend_ == DumpBackend::Uring && !uring_.setup(4)) backend_ = DumpBackend::Write;
+#else
+        if (backend_ == DumpBackend::Uring) backend_ = DumpBackend::Write;
+#endif
+        if (backend_ == DumpBackend::Write) {
+            stop_ = false;
+            io_ = std::thread([this]() { io_loop(); });
+        }
+        return true;
+    }
+
+    // Space for `bytes` (<= SLACK) contiguous bytes of output.
+    RCPA_INLINE uint8_t* reserve(size_t bytes) {
+        if (pos_ >= cap_) rotate();
+        uint8_t* p = cur_ + pos_;
+        pos_ += bytes;
+        return p;
+    }
+
+    // Writes what is buffered and waits for all I/O; false on any error.
+    bool close() {
+        if (cur_ == NULL && fd_ < 0) return ok_;
+        if (backend_ == DumpBackend::Mmap) {
+            if (map_ != NULL) {
+                file_off_ = static_cast<unsigned long long>(cur_ - map_) + pos_;
+                ok_ = (msync(map_, map_bytes_, MS_ASYNC) == 0) && ok_;
+                munmap(map_, map_bytes_);
+                map_ = NULL;
+            }
+        } else if (cur_ != NULL) {
+            if (pos_ >= cap_) rotate();
+            finish_tail();
+            if (io_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+                    stop_ = true;
+                }
+                cv_.notify_all();
+                io_.join();
+            }
+#if RCPA_HAVE_URING
+            uring_.close();
+#endif
+            for (int b = 0; b < 2; b++) {
+                std::free(buf_[b]);
+                buf_[b] = NULL;
+            }
+        }
+        cur_ = NULL;
+        pos_ = 0;
+        if (fd_ >= 0 && own_fd_) ok_ = (::close(fd_) == 0) && ok_;
+        fd_ = -1;
+        return ok_;
+    }
+
+private:
+    // Hand the full buffer to the backend and continue in the other one;
+    // bytes written past cap_ move to the front of the next buffer.
+    void rotate() {
+        const size_t over = pos_ - cap_;
+        if (backend_ == DumpBackend::Mmap) {
+            msync(cur_, cap_, MS_ASYNC);
+            cur_ += cap_;
+            pos_ = over;
+            return;
+        }
+        const int full = cur_b_;
+        const int next = 1 - cur_b_;
+        submit(full, cap_);
+        wait(next);
+        if (over) std::memcpy(buf_[next], buf_[full] + cap_, over);
+        cur_b_ = next;
+        cur_ = buf_[next];
+        pos_ = over;
+    }
+
+    void submit(int b, size_t len) {
+        const unsigned long long off = file_off_;
+        file_off_ += len;
+        if (backend_ == DumpBackend::Null) return;
+#if RCPA_HAVE_URING
+        if (backend_ == DumpBackend::Uring) {
+            // Pipes have no offsets: keep one write in flight so data stays in order.
+            if (!seekable_) wait(1 - b);
+            busy_[b] = true;
+            pending_[b].off = off;
+            pending_[b].len = len;
+            if (!uring_.write(fd_, buf_[b], static_cast<unsigned>(len), seekable_ ? off : ~0ull,
+                              static_cast<unsigned long long>(b)))
+                ok_ = false;
+            return;
+        }
+#endif
+        std::lock_guard<std::mutex> guard(lock_);
+        busy_[b] = true;
+        pending_[b].off = off;
+        pending_[b].len = len;
+        queue_[queued_++ % 2] = b;
+        cv_.notify_all();
+    }
+
+    void wait(int b) {
+        if (backend_ == DumpBackend::Null) return;
+#if RCPA_HAVE_URING
+        if (backend_ == DumpBackend::Uring) {
+            while (busy_[b]) {
+                unsigned long long tag = 0;
+                int res = 0;
+                if (!uring_.wait(tag, res)) {
+                    ok_ = false;
+                    return;
+                }
+                const int done = static_cast<int>(tag);
+                // Short or failed async write: finish it synchronously.
+                if (res < 0 || static_cast<size_t>(res) < pending_[done].len) {
+                    const size_t got = res < 0 ? 0 : static_cast<size_t>(res);
+                    if (!write_all(buf_[done] + got, pending_[done].len - got, pending_[done].off + got)) ok_ = false;
+                }
+                busy_[done] = false;
+            }
+            return;
+        }
+#endif
+        std::unique_lock<std::mutex> guard(lock_);
+        cv_.wait(guard, [&]() { return !busy_[b]; });
+    }
+
+    void io_loop() {
+        for (;;) {
+            int b;
+            {
+                std::unique_lock<std::mutex> guard(lock_);
+                cv_.wait(guard, [&]() { return stop_ || taken_ != queued_; });
+                if (taken_ == queued_) return;
+                b = queue_[taken_ % 2];
+            }
+            const bool done = write_all(buf_[b], pending_[b].len, pending_[b].off);
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+                if (!done) ok_ = false;
+                busy_[b] = false;
+                taken_++;
+            }
+            cv_.notify_all();
+        }
+    }
+
+    bool write_all(const uint8_t* p, size_t len, unsigned long long off) {
+        while (len > 0) {
+            ssize_t w = seekable_ ? pwrite(fd_, p, len, static_cast<off_t>(off)) : ::write(fd_, p, len);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return false;
+            p += w;
+            len -= static_cast<size_t>(w);
+            off += static_cast<unsigned long long>(w);
+        }
+        return true;
+    }
+
+    // Last partial buffer: the aligned part goes through the backend, the
+    // rest is written after O_DIRECT is cleared.
+    void finish_tail() {
+        const int b = cur_b_;
+        size_t len = pos_;
+        size_t head = direct_ ? len / ALIGN * ALIGN : len;
+        if (head > 0) submit(b, head);
+        wait(0);
+        wait(1);
+        if (len > head) {
+#ifdef O_DIRECT
+            int flags = fcntl(fd_, F_GETFL);
+            if (flags >= 0) fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+#endif
+            if (backend_ != DumpBackend::Null && !write_all(buf_[b] + head, len - head, file_off_)) ok_ = false;
+            file_off_ += len - head;
+        }
+        pos_ = 0;
+    }
+
+    struct Pending {
+        unsigned long long off;
+        size_t len;
+    };
+
+    DumpBackend backend_ = DumpBackend::Write;
+    int fd_ = -1;
+    bool own_fd_ = false;
+    bool seekable_ = false;
+    bool direct_ = false;
+    bool ok_ = true;
+    size_t cap_ = 0;
+    uint8_t* cur_ = NULL;
+    size_t pos_ = 0;
+    unsigned long long file_off_ = 0;
+
+    uint8_t* buf_[2] = { NULL, NULL };
+    bool busy_[2] = { false, false };
+    Pending pending_[2];
+    int cur_b_ = 0;
+
+    uint8_t* map_ = NULL;
+    size_t map_bytes_ = 0;
+
+    std::thread io_;
+    std::mutex lock_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    int queue_[2] = { 0, 0 };
+    unsigned long long queued_ = 0;
+    unsigned long long taken_ = 0;
+#if RCPA_HAVE_URING
+    Uring uring_;
+#endif
+};
+
+// Ring visitor: the N windows of each ring state, N bytes each.
+struct DumpVisitor {
+    DumpWriter* out;
+    int n;
+
+    template <typename T>
+    RCPA_INLINE void operator()(const T* ring) {
+        uint8_t* dst = out->reserve(static_cast<size_t>(n) * n);
+        for (int h = 0; h < n; h++) {
+            if (std::is_same<T, uint8_t>::value) {
+                std::memcpy(dst + h * n, ring + h, static_cast<size_t>(n));
+            } else {
+                for (int t = 0; t < n; t++) dst[h * n + t] = static_cast<uint8_t>(ring[h + t]);
+            }
+        }
+    }
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_DUMP_HPP
@@ -0,0 +1,373 @@
+/**
+ * @file    rcpa_file.hpp
+ * @brief   Ring-compressed permutation files: one base row per N(N-1) permutations.
+ * @author  YUSHENG-HU
+ * @details
+ * A ring block of RCPA (fixed C[1..N-3]) is fully determined by its base
+ * row B, the window of row N-3 at C[N-3] (N-2 elements). load_ring() turns B
+ * into the 3N ring row and N-1 ring updates yield its N(N-1) permutations.
+ * A file therefore stores only the base rows, N-2 bytes per block instead of
+ * N(N-1)·N bytes of permutations (about N² times smaller).
+ *
+ * Layout (little-endian):
+ *   header   64 bytes : "RCPARNG1", n, record_bytes (N-2), records, runs,
+ *                       data_offset, index_offset
+ *   records  N-2 bytes each, base rows in increasing block order
+ *   index    runs x { first_block, count, first_record } (u64 each)
+ *
+ * A run is a range of consecutive RCPA blocks; a full enumeration is one
+ * run, a slice ([begin, end) of a multi-process split) or a pruned search
+ * (for_each_ring_pruned) gives several. The index maps RCPA indices to
+ * records with one binary search over the runs, so any permutation is
+ * reachable in O(log runs + N).
+ *
+ * RingFile maps the file (mmap) and decodes blocks straight from the
+ * mapping: one copy of N-2 bytes per block, then the ring updates.
+ *
+ * Usage:
+ *   rcpa::write_ring_file("p13.rng", 13);            // all 13! permutations
+ *   rcpa::RingFile f;
+ *   f.open("p13.rng");
+ *   f.for_each_ring([&](const uint8_t* ring) { ... ring + h ... });
+ *   f.permutation(k, perm);                          // k-th stored permutation
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_FILE_HPP
+#define RCPA_FILE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+// --- File Layout ---
+
+struct RingFileHeader {
+    char magic[8];               // "RCPARNG1"
+    uint32_t n;
+    uint32_t record_bytes;       // N-2
+    uint64_t records;            // stored blocks
+    uint64_t runs;               // entries of the run index
+    uint64_t data_offset;        // first record
+    uint64_t index_offset;       // first run entry
+    uint64_t reserved[2];
+};
+
+struct RingFileRun {
+    uint64_t first_block;   // RCPA block index (C[1..N-3] mixed radix)
+    uint64_t count;         // consecutive blocks
+    uint64_t first_record;  // record of first_block
+};
+
+static_assert(sizeof(RingFileHeader) == 64, "ring file header must stay 64 bytes");
+
+// Block of the ring states currently visited: C[1..N-3] as a mixed-radix
+// number, C[1] most significant (see rank / unrank in rcpa.hpp).
+inline unsigned long long block_index(int n, const int* C) {
+    unsigned long long block = 0;
+    for (int i = 1; i <= n - 3; i++) block = block * static_cast<unsigned long long>(i + 1) + C[i];
+    return block;
+}
+
+// --- Writer ---
+
+class RingFileWriter {
+public:
+    RingFileWriter() : f_(NULL), n_(0), records_(0) {}
+    ~RingFileWriter() { close(); }
+
+    bool open(const char* path, int n) {
+        close();
+        f_ = fopen(path, "wb");
+        if (f_ == NULL) return false;
+        setvbuf(f_, NULL, _IOFBF, 1 << 20);
+        n_ = n;
+        records_ = 0;
+        runs_.clear();
+        RingFileHeader h;
+        std::memset(&h, 0, sizeof(h));
+        return fwrite(&h, sizeof(h), 1, f_) == 1;
+    }
+
+    // Appends the base row of `block`; blocks must be added in increasing order.
+    template <typename T>
+    bool add(unsigned long long block, const T* base) {
+        uint8_t row[256];
+        for (int t = 0; t < n_ - 2; t++) row[t] = static_cast<uint8_t>(base[t]);
+        if (runs_.empty() || runs_.back().first_block + runs_.back().count != block) {
+            RingFileRun r = { block, 0, records_ };
+            runs_.push_back(r);
+        }
+        runs_.back().count++;
+        records_++;
+        return fwrite(row, 1, static_cast<size_t>(n_ - 2), f_) == static_cast<size_t>(n_ - 2);
+    }
+
+    // Writes the run index and the header; false on any I/O error.
+    bool close() {
+        if (f_ == NULL) return true;
+        RingFileHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "RCPARNG1", 8);
+        h.n = static_cast<uint32_t>(n_);
+        h.record_bytes = static_cast<uint32_t>(n_ - 2);
+        h.records = records_;
+        h.runs = runs_.size();
+        h.data_offset = sizeof(RingFileHeader);
+        h.index_offset = h.data_offset + records_ * h.record_bytes;
+        bool ok = runs_.empty() || fwrite(runs_.data(), sizeof(RingFileRun), runs_.size(), f_) == runs_.size();
+        ok = ok && fseek(f_, 0, SEEK_SET) == 0 && fwrite(&h, sizeof(h), 1, f_) == 1;
+        ok = (fclose(f_) == 0) && ok;
+        f_ = NULL;
+        return ok;
+    }
+
+private:
+    FILE* f_;
+    int n_;
+    uint64_t records_;
+    std::vector<RingFileRun> runs_;
+};
+
+// Ring visitor feeding a writer: the first ring state of each block holds
+// the base row in ring[0 .. N-3].
+template <class Gen>
+struct RingFileSink {
+    Gen* gen;
+    RingFileWriter* out;
+    int ring_index;
+    bool ok;
+
+    template <typename T>
+    void operator()(const T* ring) {
+        if (ring_index == 0) ok = out->add(block_index(gen->size(), gen->counters()), ring) && ok;
+        if (++ring_index == gen->size() - 1) ring_index = 0;
+    }
+};
+
+// Stores every permutation of order n (all (N-2)! blocks, one run).
+inline bool write_ring_file(const char* path, int n) {
+    RingFileWriter out;
+    if (!out.open(path, n)) return false;
+    DynamicGenerator<uint8_t> gen(n);
+    RingFileSink<DynamicGenerator<uint8_t> > sink = { &gen, &out, 0, true };
+    gen.for_each_ring(sink);
+    return out.close() && sink.ok;
+}
+
+// --- Reader ---
+
+class RingFile {
+public:
+    RingFile() : data_(NULL), size_(0), n_(0), records_(0) {}
+    ~RingFile() { close(); }
+
+    // Maps `path` and validates its header and run index.
+    bool open(const char* path) {
+        close();
+#ifdef _WIN32
+        FILE* f = fopen(path, "rb");
+        if (f == NULL) return false;
+        fseek(f, 0, SEEK_END);
+        long len = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        copy_.resize(len > 0 ? static_cast<size_t>(len) : 0);
+        bool read_ok = fread(copy_.data(), 1, copy_.size(), f) == copy_.size();
+        fclose(f);
+        if (!read_ok) return false;
+        data_ = copy_.data();
+        size_ = copy_.size();
+#else
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(RingFileHeader))) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        madvise(p, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const uint8_t*>(p);
+#endif
+        if (size_ < sizeof(RingFileHeader)) return fail();
+        RingFileHeader h;
+        std::memcpy(&h, data_, sizeof(h));
+        // Offsets and counts come from the file: bound each by the mapping
+        // before multiplying so nothing can wrap around.
+        if (std::memcmp(h.magic, "RCPARNG1", 8) != 0 || h.n < 4 || h.n > 255 || h.record_bytes != h.n - 2 ||
+            h.data_offset < sizeof(RingFileHeader) || h.data_offset > size_ ||
+            h.records > (size_ - h.data_offset) / h.record_bytes ||
+            h.data_offset + h.records * h.record_bytes != h.index_offset ||
+            h.runs > (size_ - h.index_offset) / sizeof(RingFileRun))
+            return fail();
+        runs_.resize(static_cast<size_t>(h.runs));
+        if (!runs_.empty()) std::memcpy(runs_.data(), data_ + h.index_offset, runs_.size() * sizeof(RingFileRun));
+        if (!valid_runs(static_cast<int>(h.n), h.records)) return fail();
+        n_ = static_cast<int>(h.n);
+        records_ = h.records;
+        base_ = data_ + h.data_offset;
+        return true;
+    }
+
+    void close() {
+#ifndef _WIN32
+        if (data_ != NULL) munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+        copy_.clear();
+        data_ = NULL;
+        size_ = 0;
+        runs_.clear();
+        n_ = 0;
+        records_ = 0;
+    }
+
+    int size() const { return n_; }
+    unsigned long long records() const { return records_; }
+    unsigned long long count() const { return records_ * static_cast<unsigned long long>(n_) * (n_ - 1); }
+    const std::vector<RingFileRun>& runs() const { return runs_; }
+    const uint8_t* base(unsigned long long record) const { return base_ + record * static_cast<size_t>(n_ - 2); }
+
+    // RCPA block of a record (binary search over the runs).
+    unsigned long long block_of(unsigned long long record) const {
+        size_t lo = 0, hi = runs_.size();
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if (runs_[mid].first_record <= record) lo = mid;
+            else hi = mid;
+        }
+        return runs_[lo].first_block + (record - runs_[lo].first_record);
+    }
+
+    // Record holding RCPA block `block`; false if the file does not store it.
+    bool find_block(unsigned long long block, unsigned long long& record) const {
+        size_t lo = 0, hi = runs_.size();
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if (runs_[mid].first_block <= block) lo = mid;
+            else hi = mid;
+        }
+        if (runs_.empty() || block < runs_[lo].first_block || block - runs_[lo].first_block >= runs_[lo].count)
+            return false;
+        record = runs_[lo].first_record + (block - runs_[lo].first_block);
+        return true;
+    }
+
+    // Calls visit(const uint8_t* ring) for the N-1 ring states of a record.
+    template <class Visitor>
+    void decode(unsigned long long record, Visitor&& visit) const {
+        uint8_t ring[3 * 256];
+        load(record, ring);
+        run_ring(ring, 0, n_ - 1, visit);
+    }
+
+    // All stored ring states, in file (RCPA) order.
+    template <class Visitor>
+    void for_each_ring(Visitor&& visit) const {
+        uint8_t ring[3 * 256];
+        for (unsigned long long r = 0; r < records_; r++) {
+            load(r, ring);
+            run_ring(ring, 0, n_ - 1, visit);
+        }
+    }
+
+    // Permutation number k (0 <= k < count()) of the file into perm[0..N-1].
+    void permutation(unsigned long long k, uint8_t* perm) const {
+        if (k >= count()) return;
+        const int ring_head = static_cast<int>(k % n_);
+        k /= n_;
+        const int ring_index = static_cast<int>(k % (n_ - 1));
+        uint8_t ring[3 * 256];
+        load(k / (n_ - 1), ring);
+        run_ring(ring, 0, ring_index, [](const uint8_t*) {});
+        std::memcpy(perm, ring + ring_index + ring_head, static_cast<size_t>(n_));
+    }
+
+    // Permutation with RCPA index `index` (rank / unrank order); false if
+    // its block is not stored.
+    bool lookup(unsigned long long index, uint8_t* perm) const {
+        if (n_ == 0) return false;
+        const unsigned long long per_block = static_cast<unsigned long long>(n_) * (n_ - 1);
+        unsigned long long record;
+        if (!find_block(index / per_block, record)) return false;
+        permutation(record * per_block + index % per_block, perm);
+        return true;
+    }
+
+private:
+    bool fail() {
+        close();
+        return false;
+    }
+
+    // Runs must be non-empty, inside the records and the (N-2)! blocks, and
+    // strictly ordered by block and record without overlap: block_of() and
+    // find_block() binary-search them and index the mapping directly.
+    bool valid_runs(int n, uint64_t records) const {
+        const uint64_t blocks = n - 2 <= 20 ? factorial(n - 2) : ~0ull;  // (N-2)! blocks, if it fits
+        uint64_t next_block = 0, next_record = 0;
+        for (size_t k = 0; k < runs_.size(); k++) {
+            const RingFileRun& r = runs_[k];
+            if (r.count == 0 || r.first_record < next_record || r.first_block < next_block ||
+                r.first_record > records || r.count > records - r.first_record)
+                return false;
+            if (r.first_block > blocks || r.count > blocks - r.first_block) return false;
+            next_record = r.first_record + r.count;
+            next_block = r.first_block + r.count;
+        }
+        return true;
+    }
+
+    // Ring row of a record: P1 = [B, N-2, N-1], P2 = [B, N-2] at N, P3 = [B]
+    // at 2N-1 (load_ring() in rcpa.hpp).
+    RCPA_INLINE void load(unsigned long long record, uint8_t* ring) const {
+        const int n = n_;
+        const uint8_t* B = base(record);
+        std::memcpy(ring, B, static_cast<size_t>(n - 2));
+        ring[n - 2] = static_cast<uint8_t>(n - 2);
+        ring[n - 1] = static_cast<uint8_t>(n - 1);
+        std::memcpy(ring + n, B, static_cast<size_t>(n - 2));
+        ring[2 * n - 2] = static_cast<uint8_t>(n - 2);
+        std::memcpy(ring + 2 * n - 1, B, static_cast<size_t>(n - 2));
+    }
+
+    template <class Visitor>
+    RCPA_INLINE void run_ring(uint8_t* ring, int from, int to, Visitor&& visit) const {
+        const int n = n_;
+        const int last = n - 1;
+        for (int ring_index = from; ring_index < to; ring_index++) {
+            visit(static_cast<const uint8_t*>(ring + ring_index));
+            ring[last + ring_index] = ring[n + ring_index];
+            ring[n + ring_index] = static_cast<uint8_t>(last);
+        }
+    }
+
+    const uint8_t* data_;
+    size_t size_;
+    std::vector<uint8_t> copy_;  // _WIN32: file contents instead of a mapping
+    const uint8_t* base_ = NULL;
+    int n_;
+    unsigned long long records_;
+    std::vector<RingFileRun> runs_;
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_FILE_HPP
@@ -0,0 +1,191 @@
+/**
+ * @file rcpa_lanes.cpp
+ * @brief Per-core throughput: single-lane RCPA vs lane-parallel SoA RCPA
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Runs the single-lane engine (rcpa.hpp) and LaneGenerator (rcpa_lanes.hpp)
+ * with 8, 16 and 32 uint8_t lanes on one pinned core, all with the same
+ * order-independent checksum visitor, and prints one REPORT block per
+ * engine. Every engine must report the single-lane checksum. With --verify
+ * each engine is also checked for exactly-once coverage (rcpa_coverage.hpp,
+ * untimed).
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_lanes.cpp -o rcpa_lanes -pthread
+ * Usage: ./rcpa_lanes <n> [--isa=scalar|sse4.2|avx2|avx512] [--verify]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_dispatch.hpp"
+#include "rcpa_lanes.hpp"
+#include "rcpa_parallel.hpp"
+
+struct LaneResult {
+    double duration;
+    unsigned long long checksum;
+    bool passed;  // exactly-once check, if requested
+};
+
+// Same checksum as rcpa_parallel.cpp, summed over the live lanes.
+template <int L>
+struct LaneChecksum {
+    int n;
+    unsigned long long sum;
+
+    void operator()(const uint8_t* ring, int live) {
+        const uint8_t* tail = ring + (n - 1) * L;
+        for (int l = 0; l < live; l++) sum += static_cast<unsigned long long>(ring[l] * n + tail[l]);
+    }
+};
+
+// Gathers the 2N-1 ring entries of every live lane into a contiguous row
+// for the coverage check.
+template <int L>
+struct LaneCoverage {
+    rcpa::RingCoverage<uint8_t> cover;
+    uint8_t row[2 * rcpa::COVERAGE_MAX_N];
+
+    explicit LaneCoverage(rcpa::ShardedCoverage* seen) : cover(seen) {}
+
+    void operator()(const uint8_t* ring, int live) {
+        const int width = 2 * cover.seen->n() - 1;
+        for (int l = 0; l < live; l++) {
+            for (int t = 0; t < width; t++) row[t] = ring[t * L + l];
+            cover(row);
+        }
+    }
+};
+
+// Single-lane engine (lanes == 1) or LaneGenerator<uint8_t, LANES>, compiled
+// for one ISA variant (see rcpa::dispatch).
+template <int LANES>
+struct LaneKernel {
+    int n;
+    bool verify;
+    LaneResult* result;
+
+    template <class Tag>
+    void operator()(Tag) {
+        unsigned long long sum = 0;
+        auto start_point = std::chrono::high_resolution_clock::now();
+        if (LANES == 1) {
+            rcpa::DynamicGenerator<uint8_t> generator(n);
+            const int tail = n - 1;
+            generator.for_each_ring([&](const uint8_t* ring) {
+                sum += static_cast<unsigned long long>(ring[0] * n + ring[tail]);
+            });
+        } else {
+            rcpa::LaneGenerator<uint8_t, LANES> generator(n);
+            LaneChecksum<LANES> visit = { n, 0 };
+            generator.for_each_ring(visit);
+            sum = visit.sum;
+        }
+        auto end_point = std::chrono::high_resolution_clock::now();
+        result->duration = std::chrono::duration<double>(end_point - start_point).count();
+        result->checksum = sum;
+
+        // Optional exactly-once check, outside the timed run
+        if (verify) {
+            rcpa::ShardedCoverage seen(n);
+            rcpa::CoverageResult r;
+            if (LANES == 1) {
+                rcpa::DynamicGenerator<uint8_t> generator(n);
+                rcpa::RingCoverage<uint8_t> cover(&seen);
+                generator.for_each_ring(cover);
+                cover.finish();
+                r = seen.result(cover.visited, cover.duplicates);
+            } else {
+                rcpa::LaneGenerator<uint8_t, LANES> generator(n);
+                LaneCoverage<LANES> cover(&seen);
+                generator.for_each_ring(cover);
+                cover.cover.finish();
+                r = seen.result(cover.cover.visited, cover.cover.duplicates);
+            }
+            result->passed = r.pass();
+        }
+    }
+};
+
+template <int LANES>
+LaneResult run_lanes(int n, rcpa::Isa isa, bool verify) {
+    LaneResult result = { 0.0, 0, true };
+    LaneKernel<LANES> kernel = { n, verify, &result };
+    rcpa::dispatch(isa, kernel);
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const char* isa_flag = NULL;
+    const char* n_arg = NULL;
+    bool verify = false;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--isa=", 6) == 0) isa_flag = argv[a] + 6;
+        else if (std::strcmp(argv[a], "--verify") == 0) verify = true;
+        else n_arg = argv[a];
+    }
+    if (n_arg == NULL) {
+        fprintf(stderr, "Usage: %s <n> [--isa=scalar|sse4.2|avx2|avx512] [--verify]\n", argv[0]);
+        return 1;
+    }
+    int n_val = std::atoi(n_arg);
+    if (n_val <= 3 || n_val > 20) {
+        fprintf(stderr, "Error: n must be in 4..20 for the lane benchmark.\n");
+        return 1;
+    }
+    if (verify && n_val > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports n <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    rcpa::Isa isa;
+    if (!rcpa::resolve_isa(isa_flag, isa)) return 1;
+
+    // Per-core throughput: everything runs on one pinned core.
+    rcpa::pin_thread_to_core(0);
+
+    const int lane_counts[] = { 1, 8, 16, 32 };
+    const unsigned long long total_perms = rcpa::factorial(n_val);
+    double base_time = 0.0;
+    unsigned long long base_checksum = 0;
+
+    for (int lanes : lane_counts) {
+        LaneResult r;
+        switch (lanes) {
+        case 8: r = run_lanes<8>(n_val, isa, verify); break;
+        case 16: r = run_lanes<16>(n_val, isa, verify); break;
+        case 32: r = run_lanes<32>(n_val, isa, verify); break;
+        default: r = run_lanes<1>(n_val, isa, verify); break;
+        }
+        if (lanes == 1) {
+            base_time = r.duration;
+            base_checksum = r.checksum;
+        } else if (r.checksum != base_checksum) {
+            fprintf(stderr, "Error: %d lanes checksum %llu != single-lane %llu.\n",
+                    lanes, r.checksum, base_checksum);
+            return 1;
+        }
+
+        // --- Standardized Report Output ---
+        printf("\nREPORT_START");
+        printf("\nALGORITHM: %s", lanes == 1 ? "rcpa_single_lane" : "rcpa_lanes");
+        printf("\nISA: %s", rcpa::isa_name(isa));
+        printf("\nN_VALUE: %d", n_val);
+        printf("\nLANES: %d", lanes);
+        printf("\nSHARD_DEPTH: %d", lanes == 1 ? 0 : rcpa::lane_depth(n_val, lanes));
+        printf("\nEXECUTION_TIME: %lf", r.duration);
+        printf("\nSPEED: %.2f", (total_perms / r.duration) / 1e9);
+        printf("\nSPEEDUP: %.2f", base_time / r.duration);
+        printf("\nCHECKSUM: %llu", r.checksum);
+        if (verify) printf("\nVERIFY: %s", r.passed ? "PASS" : "FAIL");
+        printf("\nREPORT_END\n");
+        if (!r.passed) return 1;
+    }
+
+    return 0;
+}
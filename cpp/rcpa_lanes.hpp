@@ -0,0 +1,202 @@
+/**
+ * @file    rcpa_lanes.hpp
+ * @brief   Lane-parallel RCPA: L independent shards interleaved in SIMD lanes.
+ * @author  YUSHENG-HU
+ * @details
+ * Shards of the same depth (rcpa_parallel.hpp) differ only in the top
+ * counters C[1..depth]; below that every shard runs the identical counter
+ * sequence. LaneGenerator runs L such shards in lockstep on one core:
+ *
+ *   - C[depth+1 .. N-3] are shared scalars, so the carry loop runs once for
+ *     all lanes and never diverges;
+ *   - D is stored struct-of-arrays, element (row, pos) of lane l at
+ *     rows[(row * 3N + pos) * L + l], so every cascade memcpy and every ring
+ *     update moves the values of all L lanes with one vector copy.
+ * Only rows 1..depth+1 depend on per-lane counters; they are built once per
+ * lane group with a scalar gather.
+ *
+ * Visitors receive visit(const T* ring, int live): position t of lane l is
+ * ring[t * L + l], and the N windows h = 0 ... N-1 of each lane are its
+ * permutations (as in rcpa.hpp). The last group of a run may hold fewer
+ * than L shards. Lanes live ... L-1 then repeat the group's first shard and
+ * must be ignored.
+ *
+ * Usage:
+ *   rcpa::LaneGenerator<uint8_t, 16> gen(n);
+ *   gen.for_each_ring([&](const uint8_t* ring, int live) {
+ *       for (int l = 0; l < live; l++) ... ring[t * 16 + l] ...
+ *   });
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_LANES_HPP
+#define RCPA_LANES_HPP
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+// Shard depth for L lanes: the smallest depth whose (depth+1)! shards fill
+// every lane group, so no lane idles. Capped at N-4 so that the counter
+// C[N-3] feeding the ring row stays shared.
+inline int lane_depth(int n, int lanes) {
+    const int max_depth = (n > 4) ? n - 4 : 0;
+    int depth = 0;
+    while (depth < max_depth && shard_count(depth) % static_cast<unsigned long long>(lanes) != 0) depth++;
+    return depth;
+}
+
+template <typename T = uint8_t, int L = 16>
+class LaneGenerator {
+    static_assert(L > 0, "at least one lane");
+
+public:
+    typedef T value_type;
+
+    explicit LaneGenerator(int n)
+        : n_(n),
+          C_(static_cast<size_t>(n), 0),
+          rows_(static_cast<size_t>(n) * 3 * n * L, 0),
+          lane_row_(static_cast<size_t>(n), 0),
+          lane_next_(static_cast<size_t>(n), 0) {
+        // Pivot element j of every row j never changes.
+        for (int j = 0; j < n - 2; j++) fill(row_ptr(j) + j * L, static_cast<T>(j));
+    }
+
+    int size() const { return n_; }
+    static constexpr int lanes() { return L; }
+    unsigned long long count() const { return factorial(n_); }
+
+    // Calls visit(ring, live) once per lane-group ring state; covers all N!
+    // permutations.
+    template <class Visitor>
+    void for_each_ring(Visitor&& visit) {
+        const int depth = lane_depth(n_, L);
+        const unsigned long long shards = shard_count(depth);
+        for (unsigned long long first = 0; first < shards; first += L) {
+            const unsigned long long left = shards - first;
+            const int live = (left < static_cast<unsigned long long>(L)) ? static_cast<int>(left) : L;
+            for_each_ring_in_group(depth, first, live, visit);
+        }
+    }
+
+    // Runs shards first ... first+live-1 of the given depth in lockstep.
+    template <class Visitor>
+    void for_each_ring_in_group(int depth, unsigned long long first, int live, Visitor&& visit) {
+        for (int l = 0; l < L; l++) load_lane(l, depth, first + static_cast<unsigned long long>(l < live ? l : 0));
+        for (int i = 0; i < n_; i++) C_[i] = 0;
+        run_rings(visit, depth, live);
+    }
+
+private:
+    RCPA_INLINE T* row_ptr(int i) { return &rows_[static_cast<size_t>(i) * 3 * n_ * L]; }
+
+    static RCPA_INLINE void fill(T* dst, T value) {
+        for (int l = 0; l < L; l++) dst[l] = value;
+    }
+
+    // Scalar gather: rows 1..depth+1 of lane l for the given shard (those are
+    // the rows that read per-lane counters C[0..depth]).
+    void load_lane(int l, int depth, unsigned long long shard) {
+        std::vector<int> lane_C(static_cast<size_t>(depth + 1), 0);
+        for (int i = depth; i > 0; i--) {
+            lane_C[i] = static_cast<int>(shard % static_cast<unsigned long long>(i + 1));
+            shard /= static_cast<unsigned long long>(i + 1);
+        }
+        int* row = lane_row_.data();
+        int* next = lane_next_.data();
+        row[0] = 0;
+        for (int j = 1; j <= depth + 1 && j < n_ - 2; j++) {
+            for (int t = 0; t < j; t++) next[t] = row[(lane_C[j - 1] + t) % j];
+            T* D = row_ptr(j);
+            for (int t = 0; t < j; t++) {
+                D[t * L + l] = static_cast<T>(next[t]);
+                D[(t + j + 1) * L + l] = static_cast<T>(next[t]);
+            }
+            next[j] = j;
+            std::swap(row, next);
+        }
+    }
+
+    // Rebuild row j of all lanes from the window of row j-1 selected by the
+    // shared C[j-1].
+    RCPA_INLINE void cascade_row(int j) {
+        const T* src_ptr = row_ptr(j - 1) + C_[j - 1] * L;
+        T* D = row_ptr(j);
+        std::memcpy(D, src_ptr, static_cast<size_t>(j) * L * sizeof(T));
+        std::memcpy(D + (j + 1) * L, src_ptr, static_cast<size_t>(j) * L * sizeof(T));
+    }
+
+    RCPA_INLINE void load_ring() {
+        const int n = n_;
+        const int last = n - 1;
+        const int second_last = n - 2;
+        const int third_last = n - 3;
+        const size_t memcpy_size = static_cast<size_t>(second_last) * L * sizeof(T);
+
+        T* P1 = row_ptr(last);
+        T* P2 = P1 + n * L;
+        T* P3 = P1 + (n * 2 - 1) * L;
+        const T* src_ptr = row_ptr(third_last) + C_[third_last] * L;
+        std::memcpy(P1, src_ptr, memcpy_size);
+        fill(P1 + second_last * L, static_cast<T>(second_last));
+        fill(P1 + last * L, static_cast<T>(last));
+        std::memcpy(P2, src_ptr, memcpy_size);
+        fill(P2 + second_last * L, static_cast<T>(second_last));
+        std::memcpy(P3, src_ptr, memcpy_size);
+    }
+
+    template <class Visitor>
+    void run_rings(Visitor& visit, int depth, int live) {
+        const int n = n_;
+        const int last = n - 1;
+        const int second_last = n - 2;
+        const int third_last = n - 3;
+        int* C = C_.data();
+        T* ring = row_ptr(last);
+
+        // Rows 0..depth+1 were gathered per lane by load_lane(). Operation
+        // counts cover the live lanes only, so per permutation they compare
+        // with the scalar generator.
+        int i_loop = depth + 1;
+        for (;;) {
+            for (int j = i_loop + 1; j < second_last; j++) {
+                cascade_row(j);
+                RCPA_COUNT_OP(cascade_bytes, 2 * static_cast<size_t>(j) * live * sizeof(T));
+            }
+            load_ring();
+            RCPA_COUNT_OP(cascade_bytes, 3 * static_cast<size_t>(second_last) * live * sizeof(T));
+
+            for (int ring_index = 0; ring_index < last; ring_index++) {
+                visit(static_cast<const T*>(ring + ring_index * L), live);
+                std::memcpy(ring + (last + ring_index) * L, ring + (n + ring_index) * L, L * sizeof(T));
+                fill(ring + (n + ring_index) * L, static_cast<T>(last));
+            }
+            RCPA_COUNT_OP(ring_updates, last * live);
+            RCPA_COUNT_OP(perms, n * last * live);
+
+            C[third_last]++;
+            for (i_loop = third_last; (i_loop > depth) && (C[i_loop] > i_loop); i_loop--) {
+                RCPA_COUNT_CARRY(i_loop);
+                C[i_loop] = 0;
+                C[i_loop - 1]++;
+            }
+            if (i_loop <= depth) break;
+        }
+    }
+
+    int n_;
+    std::vector<int> C_;     // shared counters; only C[depth+1 .. N-3] are used
+    std::vector<T> rows_;    // N rows of 3N positions x L lanes
+    std::vector<int> lane_row_, lane_next_;
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_LANES_HPP
@@ -0,0 +1,222 @@
+/**
+ * @file    rcpa_numa.hpp
+ * @brief   NUMA topology, worker placement across nodes and first-touch buffers.
+ * @author  YUSHENG-HU
+ * @details
+ * On a multi-socket host, pinning worker w to core w fills one socket before
+ * the next and leaves buffers wherever the allocating thread ran. This header
+ * reads the topology from /sys/devices/system/node (no libnuma needed):
+ *
+ *   - read_numa_topology() : the nodes and their CPUs, restricted to the CPUs
+ *                            the process may run on (sched_getaffinity).
+ *                            Without sysfs (other OS, containers that hide it)
+ *                            it returns one node holding every allowed CPU.
+ *   - place_workers()      : one CPU slot per worker. SPREAD deals workers to
+ *                            the nodes in turn (worker w on node w mod nodes),
+ *                            COMPACT fills node 0 first.
+ *   - first_touch()        : writes a buffer from a thread pinned to a given
+ *                            CPU, so Linux backs its pages on that CPU's node.
+ *
+ * Memory placement relies on first touch: a worker that allocates and writes
+ * its own state after pinning (as the generators of rcpa_parallel.hpp do)
+ * gets node-local pages. Buffers allocated elsewhere should be created
+ * untouched and passed through first_touch(). Small allocations may reuse
+ * pages the heap already touched; only large buffers are reliably placed.
+ *
+ * Usage:
+ *   rcpa::NumaTopology topo = rcpa::read_numa_topology();
+ *   std::vector<rcpa::CpuSlot> slots = rcpa::place_workers(topo, threads);
+ *   // worker w: rcpa::pin_thread_to_core(slots[w].cpu); results per slots[w].node
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_NUMA_HPP
+#define RCPA_NUMA_HPP
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+namespace rcpa {
+
+inline void pin_thread_to_core(unsigned core_id) {
+#ifdef _WIN32
+    SetThreadAffinityMask(GetCurrentThread(), 1ull << core_id);
+#else
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(core_id, &cpuset);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset);
+#endif
+}
+
+// --- Topology ---
+
+struct NumaNode {
+    int id;
+    std::vector<unsigned> cpus;
+};
+
+struct NumaTopology {
+    std::vector<NumaNode> nodes;  // by id; every node has at least one CPU
+
+    unsigned cpu_count() const {
+        unsigned count = 0;
+        for (size_t k = 0; k < nodes.size(); k++) count += static_cast<unsigned>(nodes[k].cpus.size());
+        return count;
+    }
+
+    // Node of `cpu`, or -1 if it is not in the topology.
+    int node_of(unsigned cpu) const {
+        for (size_t k = 0; k < nodes.size(); k++) {
+            if (std::find(nodes[k].cpus.begin(), nodes[k].cpus.end(), cpu) != nodes[k].cpus.end()) return nodes[k].id;
+        }
+        return -1;
+    }
+};
+
+// Parses a sysfs CPU list such as "0-3,8-11,16".
+inline bool parse_cpulist(const char* s, std::vector<unsigned>& out) {
+    out.clear();
+    while (*s && *s != '\n') {
+        char* end;
+        const unsigned long lo = std::strtoul(s, &end, 10);
+        if (end == s) return false;
+        unsigned long hi = lo;
+        s = end;
+        if (*s == '-') {
+            hi = std::strtoul(s + 1, &end, 10);
+            if (end == s + 1 || hi < lo) return false;
+            s = end;
+        }
+        for (unsigned long c = lo; c <= hi; c++) out.push_back(static_cast<unsigned>(c));
+        if (*s == ',') s++;
+        else if (*s && *s != '\n') return false;
+    }
+    return true;
+}
+
+inline NumaTopology read_numa_topology() {
+    NumaTopology topo;
+#ifndef _WIN32
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    const bool have_mask = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+
+    if (DIR* dir = opendir("/sys/devices/system/node")) {
+        while (dirent* entry = readdir(dir)) {
+            int id;
+            char tail;
+            if (std::sscanf(entry->d_name, "node%d%c", &id, &tail) != 1) continue;
+            char path[96];
+            std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+            FILE* f = std::fopen(path, "r");
+            if (!f) continue;
+            char line[4096];
+            NumaNode node;
+            node.id = id;
+            std::vector<unsigned> cpus;
+            if (std::fgets(line, sizeof(line), f) && parse_cpulist(line, cpus)) {
+                for (size_t k = 0; k < cpus.size(); k++) {
+                    if (!have_mask || (cpus[k] < CPU_SETSIZE && CPU_ISSET(cpus[k], &allowed))) node.cpus.push_back(cpus[k]);
+                }
+            }
+            std::fclose(f);
+            if (!node.cpus.empty()) topo.nodes.push_back(node);
+        }
+        closedir(dir);
+    }
+    std::sort(topo.nodes.begin(), topo.nodes.end(),
+              [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+    if (!topo.nodes.empty()) return topo;
+
+    // No sysfs topology: one node with the allowed CPUs.
+    NumaNode all;
+    all.id = 0;
+    if (have_mask) {
+        for (unsigned c = 0; c < CPU_SETSIZE; c++) {
+            if (CPU_ISSET(c, &allowed)) all.cpus.push_back(c);
+        }
+    }
+#else
+    NumaNode all;
+    all.id = 0;
+#endif
+    if (all.cpus.empty()) {
+        unsigned cores = std::thread::hardware_concurrency();
+        if (cores == 0) cores = 1;
+        for (unsigned c = 0; c < cores; c++) all.cpus.push_back(c);
+    }
+    topo.nodes.push_back(all);
+    return topo;
+}
+
+// --- Placement ---
+
+enum PlacementPolicy {
+    PLACE_SPREAD,   // worker w on node w mod nodes
+    PLACE_COMPACT   // fill node 0, then node 1, ...
+};
+
+struct CpuSlot {
+    unsigned cpu;
+    int node;
+};
+
+// One slot per worker; CPUs are reused round-robin once every CPU has a worker.
+inline std::vector<CpuSlot> place_workers(const NumaTopology& topo, unsigned workers,
+                                          PlacementPolicy policy = PLACE_SPREAD) {
+    // Order in which CPUs are handed out: node by node (COMPACT), or the
+    // r-th CPU of every node before the (r+1)-th of any (SPREAD).
+    std::vector<CpuSlot> order;
+    if (policy == PLACE_COMPACT) {
+        for (size_t k = 0; k < topo.nodes.size(); k++) {
+            for (size_t i = 0; i < topo.nodes[k].cpus.size(); i++) {
+                CpuSlot slot = { topo.nodes[k].cpus[i], topo.nodes[k].id };
+                order.push_back(slot);
+            }
+        }
+    } else {
+        for (size_t r = 0; order.size() < topo.cpu_count(); r++) {
+            for (size_t k = 0; k < topo.nodes.size(); k++) {
+                if (r >= topo.nodes[k].cpus.size()) continue;
+                CpuSlot slot = { topo.nodes[k].cpus[r], topo.nodes[k].id };
+                order.push_back(slot);
+            }
+        }
+    }
+
+    std::vector<CpuSlot> slots;
+    slots.reserve(workers);
+    for (unsigned w = 0; w < workers; w++) slots.push_back(order[w % order.size()]);
+    return slots;
+}
+
+// --- First Touch ---
+
+// Writes `bytes` zero bytes at `p` from a thread pinned to `cpu`, so the
+// pages are placed on that CPU's node.
+inline void first_touch(void* p, size_t bytes, unsigned cpu) {
+    std::thread toucher([=]() {
+        pin_thread_to_core(cpu);
+        std::memset(p, 0, bytes);
+    });
+    toucher.join();
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_NUMA_HPP
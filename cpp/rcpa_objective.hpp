@@ -0,0 +1,269 @@
+/**
+ * @file    rcpa_objective.hpp
+ * @brief   Fused objective evaluation over RCPA ring rotations (min / max / top-k).
+ * @author  YUSHENG-HU
+ * @details
+ * The N windows of a ring state are the cyclic rotations of one sequence:
+ * window h+1 is window h shifted left by one, and the ring buffer stores
+ * window[N] == window[0]. A cost model therefore only needs a full O(N)
+ * evaluation once per ring state and an O(1) update per rotation:
+ *
+ *   struct Cost {
+ *       typedef double value_type;
+ *       template <typename T> value_type full(const T* perm) const;          // O(N)
+ *       template <typename T> value_type rotate(value_type c, const T* perm) const;
+ *           // cost of perm + 1 (perm rotated left by one), given c = cost of perm
+ *   };
+ *
+ * rcpa::optimize() drives any generator with for_each_ring() and reports the
+ * minimum, the maximum and the k best permutations with their enumeration
+ * index. For rcpa.hpp generators that index is the RCPA index, so
+ * rcpa::unrank(n, index, perm) recovers the permutation.
+ *
+ * Ready-made models: PathCost (open path over a distance matrix), TourCost
+ * (closed tour, rotation invariant) and AssignmentCost (position x value
+ * matrix; no O(1) update, so rotate() re-evaluates).
+ *
+ * Usage:
+ *   rcpa::DynamicGenerator<uint8_t> gen(n);
+ *   rcpa::PathCost<double> cost(n, dist);
+ *   rcpa::ObjectiveOptions opt;
+ *   opt.top_k = 10;
+ *   auto result = rcpa::optimize(gen, cost, opt);
+ *   // result.min.cost, result.min.index, result.top[0 .. 9]
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_OBJECTIVE_HPP
+#define RCPA_OBJECTIVE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+// --- Results ---
+
+template <typename V>
+struct Scored {
+    V cost;
+    unsigned long long index;  // enumeration index (RCPA index for rcpa.hpp)
+};
+
+template <typename V>
+struct ObjectiveResult {
+    Scored<V> min;
+    Scored<V> max;
+    std::vector<Scored<V> > top;  // k best, best first
+    std::vector<int> min_perm;
+    std::vector<int> max_perm;
+    unsigned long long evaluated = 0;
+};
+
+struct ObjectiveOptions {
+    size_t top_k = 0;       // size of the top list (0 = min/max only)
+    bool maximize = false;  // top list holds the largest costs instead
+};
+
+// Ring visitor: full evaluation per ring state, rotate() for the other N-1
+// windows. The hot loop only compares against cached bounds (min, max and the
+// worst cost still admitted to the top list); updates take the slow path.
+// Ties keep the lowest index.
+template <class Cost, typename T>
+class ObjectiveVisitor {
+public:
+    typedef typename Cost::value_type value_type;
+
+    ObjectiveVisitor(int n, const Cost& cost, const ObjectiveOptions& opt)
+        : n_(n), cost_(cost), opt_(opt), index_(0), open_(opt.top_k > 0) {
+        result_.min.cost = std::numeric_limits<value_type>::max();
+        result_.max.cost = std::numeric_limits<value_type>::lowest();
+        result_.min.index = result_.max.index = 0;
+        result_.min_perm.resize(static_cast<size_t>(n));
+        result_.max_perm.resize(static_cast<size_t>(n));
+        heap_.reserve(opt.top_k + 1);
+    }
+
+    // Index of the next permutation visited, e.g. the first RCPA index of a
+    // shard (shard * N! / (depth+1)!) before for_each_ring_in_shard().
+    void seek(unsigned long long index) { index_ = index; }
+
+    void operator()(const T* ring) {
+        value_type c = cost_.full(ring);
+        const unsigned long long base = index_;
+        index_ += static_cast<unsigned long long>(n_);
+        evaluated_ += static_cast<unsigned long long>(n_);
+        for (int h = 0;;) {
+            if (hit(c)) record(c, base + h, ring + h);
+            if (++h == n_) break;
+            c = cost_.rotate(c, ring + h - 1);
+        }
+    }
+
+    // Final result; the top list is sorted best first.
+    ObjectiveResult<value_type> result() {
+        ObjectiveResult<value_type> out = result_;
+        out.evaluated = evaluated_;
+        out.top = heap_;
+        std::sort(out.top.begin(), out.top.end(), Better(opt_.maximize));
+        return out;
+    }
+
+private:
+    // Strict order of the top list: better cost, then lower index.
+    struct Better {
+        bool maximize;
+        explicit Better(bool m) : maximize(m) {}
+        bool operator()(const Scored<value_type>& a, const Scored<value_type>& b) const {
+            if (a.cost != b.cost) return maximize ? (a.cost > b.cost) : (a.cost < b.cost);
+            return a.index < b.index;
+        }
+    };
+
+    // Later indices lose ties, so only strictly better costs can change anything.
+    RCPA_INLINE bool hit(value_type c) const {
+        if (c < result_.min.cost || c > result_.max.cost || open_) return true;
+        if (opt_.top_k == 0) return false;
+        return opt_.maximize ? (c > gate_) : (c < gate_);
+    }
+
+    void record(value_type c, unsigned long long index, const T* perm) {
+        if (c < result_.min.cost) {
+            result_.min.cost = c;
+            result_.min.index = index;
+            copy_perm(result_.min_perm, perm);
+        }
+        if (c > result_.max.cost) {
+            result_.max.cost = c;
+            result_.max.index = index;
+            copy_perm(result_.max_perm, perm);
+        }
+        if (opt_.top_k == 0) return;
+
+        // Max-heap on Better: front() is the worst entry of the top list.
+        Scored<value_type> s = { c, index };
+        const Better better(opt_.maximize);
+        if (open_) {
+            heap_.push_back(s);
+            std::push_heap(heap_.begin(), heap_.end(), better);
+            open_ = heap_.size() < opt_.top_k;
+        } else if (better(s, heap_.front())) {
+            std::pop_heap(heap_.begin(), heap_.end(), better);
+            heap_.back() = s;
+            std::push_heap(heap_.begin(), heap_.end(), better);
+        }
+        gate_ = heap_.front().cost;
+    }
+
+    void copy_perm(std::vector<int>& dst, const T* perm) {
+        for (int t = 0; t < n_; t++) dst[t] = static_cast<int>(perm[t]);
+    }
+
+    int n_;
+    Cost cost_;
+    ObjectiveOptions opt_;
+    unsigned long long index_;
+    unsigned long long evaluated_ = 0;
+    bool open_;          // top list not full yet: every cost is admitted
+    value_type gate_{};  // cost of the worst top-list entry
+    ObjectiveResult<value_type> result_;
+    std::vector<Scored<value_type> > heap_;
+};
+
+// Enumerates every permutation of `gen` through the cost model.
+template <class Gen, class Cost>
+ObjectiveResult<typename Cost::value_type> optimize(Gen& gen, const Cost& cost,
+                                                    const ObjectiveOptions& opt = ObjectiveOptions()) {
+    typedef typename Gen::value_type T;
+    ObjectiveVisitor<Cost, T> visit(gen.size(), cost, opt);
+    gen.for_each_ring(visit);
+    return visit.result();
+}
+
+// --- Cost Models ---
+
+// Open path p0 -> p1 -> ... -> p(N-1) over a row-major N x N distance
+// matrix. Rotating drops the edge (p0, p1) and appends (p(N-1), p0).
+template <typename V = double>
+class PathCost {
+public:
+    typedef V value_type;
+
+    PathCost(int n, const V* dist) : n_(n), dist_(dist) {}
+
+    template <typename T>
+    V full(const T* perm) const {
+        V c = V();
+        for (int t = 0; t + 1 < n_; t++) c += d(perm[t], perm[t + 1]);
+        return c;
+    }
+
+    template <typename T>
+    RCPA_INLINE V rotate(V c, const T* perm) const {
+        return c - d(perm[0], perm[1]) + d(perm[n_ - 1], perm[0]);
+    }
+
+private:
+    template <typename T>
+    RCPA_INLINE V d(T a, T b) const { return dist_[static_cast<size_t>(a) * n_ + b]; }
+
+    int n_;
+    const V* dist_;
+};
+
+// Closed tour p0 -> ... -> p(N-1) -> p0: every rotation is the same tour.
+template <typename V = double>
+class TourCost {
+public:
+    typedef V value_type;
+
+    TourCost(int n, const V* dist) : n_(n), dist_(dist) {}
+
+    template <typename T>
+    V full(const T* perm) const {
+        V c = dist_[static_cast<size_t>(perm[n_ - 1]) * n_ + perm[0]];
+        for (int t = 0; t + 1 < n_; t++) c += dist_[static_cast<size_t>(perm[t]) * n_ + perm[t + 1]];
+        return c;
+    }
+
+    template <typename T>
+    RCPA_INLINE V rotate(V c, const T*) const { return c; }
+
+private:
+    int n_;
+    const V* dist_;
+};
+
+// Assignment sum w[t][perm[t]] over a row-major N x N matrix. A rotation
+// moves every element, so rotate() falls back to a full evaluation.
+template <typename V = double>
+class AssignmentCost {
+public:
+    typedef V value_type;
+
+    AssignmentCost(int n, const V* weight) : n_(n), weight_(weight) {}
+
+    template <typename T>
+    V full(const T* perm) const {
+        V c = V();
+        for (int t = 0; t < n_; t++) c += weight_[static_cast<size_t>(t) * n_ + perm[t]];
+        return c;
+    }
+
+    template <typename T>
+    RCPA_INLINE V rotate(V, const T* perm) const { return full(perm + 1); }
+
+private:
+    int n_;
+    const V* weight_;
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_OBJECTIVE_HPP
@@ -0,0 +1,130 @@
+/**
+ * @file rcpa_opcount.cpp
+ * @brief Amortized work per permutation of the generators as N grows
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Runs the RCPA cascade (rcpa.hpp), PP + ring (rcpa_pp.hpp, scalar burst; the
+ * generator of ppa_rcpa.cpp and pure_circle.cpp), the 16-lane cascade
+ * (rcpa_lanes.hpp) and the table-driven tail (rcpa_tail.hpp, scalar gather)
+ * for N = 4 ... max_n with the operation counters of rcpa_opcount.hpp
+ * switched on, and prints carries, cascade bytes, ring updates and PP swaps
+ * per emitted permutation. Heap's algorithm is a loop in heap_perm.cpp; a
+ * -DRCPA_OPCOUNT build of heap_test reports its swaps and carries itself. A generator whose
+ * amortized cost is bounded shows per-permutation values that level off or
+ * fall as N grows; a rise between two builds is extra work in a hot loop.
+ *
+ * Every run must emit exactly N! permutations; the program exits with
+ * status 1 otherwise.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_opcount.cpp -o rcpa_opcount
+ * Usage: ./rcpa_opcount [max_n] [--gen=rcpa,pp_ring,lanes16,tail] [--csv]
+ *   max_n : largest N (default 11, at most 16)
+ *   --csv : one row per (generator, N) instead of REPORT blocks
+ */
+
+#ifndef RCPA_OPCOUNT
+#define RCPA_OPCOUNT
+#endif
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+
+#include "rcpa.hpp"
+#include "rcpa_lanes.hpp"
+#include "rcpa_opcount.hpp"
+#include "rcpa_pp.hpp"
+#include "rcpa_tail.hpp"
+
+const int OPCOUNT_SWEEP_MAX_N = 16;
+
+struct NoVisit {
+    template <class... Args>
+    RCPA_INLINE void operator()(Args...) const {}
+};
+
+// TailGenerator<N> for N chosen at runtime (see rcpa::dispatch_size).
+struct TailRun {
+    template <int N>
+    void run() {
+        rcpa::TailGenerator<N, uint8_t, rcpa::Isa::Scalar> generator;
+        generator.for_each_ring(NoVisit());
+    }
+};
+
+// Runs generator `name` for N = n on fresh counters.
+bool run_generator(const std::string& name, int n) {
+    rcpa::reset_op_counts();
+    if (name == "rcpa") {
+        rcpa::DynamicGenerator<uint8_t> generator(n);
+        generator.for_each_ring(NoVisit());
+    } else if (name == "pp_ring") {
+        rcpa::DynamicPPRingGenerator<uint8_t, rcpa::BurstScalar> generator(n);
+        generator.for_each_ring(NoVisit());
+    } else if (name == "lanes16") {
+        rcpa::LaneGenerator<uint8_t, 16> generator(n);
+        generator.for_each_ring(NoVisit());
+    } else if (name == "tail") {
+        TailRun run;
+        rcpa::dispatch_size<4, OPCOUNT_SWEEP_MAX_N>(n, run);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    int max_n = 11;
+    std::string gens = "rcpa,pp_ring,lanes16,tail";
+    bool csv = false;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--gen=", 6) == 0) gens = argv[a] + 6;
+        else if (std::strcmp(argv[a], "--csv") == 0) csv = true;
+        else max_n = std::atoi(argv[a]);
+    }
+    if (max_n < 4 || max_n > OPCOUNT_SWEEP_MAX_N) {
+        fprintf(stderr, "Error: max_n must be in [4, %d].\n", OPCOUNT_SWEEP_MAX_N);
+        return 1;
+    }
+
+    if (csv) printf("algorithm,n,perms,carries_per_perm,cascade_bytes_per_perm,ring_updates_per_perm,swaps_per_perm\n");
+    size_t pos = 0;
+    while (pos <= gens.size()) {
+        size_t comma = gens.find(',', pos);
+        if (comma == std::string::npos) comma = gens.size();
+        const std::string name = gens.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        for (int n = 4; n <= max_n; n++) {
+            if (!run_generator(name, n)) {
+                fprintf(stderr, "Error: unknown generator '%s' (rcpa|pp_ring|lanes16|tail).\n", name.c_str());
+                return 1;
+            }
+            const rcpa::OpCounts& c = rcpa::op_counts();
+            if (c.perms != rcpa::factorial(n)) {
+                fprintf(stderr, "Error: %s emitted %llu of %llu permutations for n = %d.\n",
+                        name.c_str(), c.perms, rcpa::factorial(n), n);
+                return 1;
+            }
+            const double perms = static_cast<double>(c.perms);
+
+            if (csv) {
+                printf("%s,%d,%llu,%.6f,%.6f,%.6f,%.6f\n", name.c_str(), n, c.perms, rcpa::total_carries(c) / perms,
+                       c.cascade_bytes / perms, c.ring_updates / perms, c.swaps / perms);
+                continue;
+            }
+
+            // --- Standardized Report Output ---
+            printf("\nREPORT_START");
+            printf("\nALGORITHM: %s", name.c_str());
+            printf("\nN_VALUE: %d", n);
+            rcpa::write_opcount_report(stdout, c);
+            printf("\nREPORT_END\n");
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file    rcpa_opcount.hpp
+ * @brief   Algorithmic operation counters for the generators (compile-time elided).
+ * @author  YUSHENG-HU
+ * @details
+ * Counts the work the generators do, independent of the machine:
+ *
+ *   - carries[i]    : counter C[i] wrapped to 0 and carried into C[i-1]
+ *   - cascade_bytes : bytes moved by cascade / ring-load / mirror memcpy
+ *   - ring_updates  : ring state steps (one copy and one store each, or one
+ *                     shuffle + store in the SIMD bursts)
+ *   - swaps         : element moves of the Position-Pure (PP) loop
+ *   - perms         : permutations emitted
+ *
+ * Divided by perms these give the amortized work per permutation, which for
+ * the cascade should stay bounded (carries and cascade bytes shrink as N
+ * grows) while ring updates approach 1/N.
+ *
+ * Counting is off unless the build defines RCPA_OPCOUNT: RCPA_COUNT_OP and
+ * RCPA_COUNT_CARRY then expand to nothing and the hot loops are unchanged.
+ * With it on, each thread counts into its own op_counts().
+ *
+ *   g++ -O3 -DRCPA_OPCOUNT ...
+ *   rcpa::reset_op_counts();
+ *   gen.for_each_ring(visit);
+ *   rcpa::write_opcount_report(stdout, rcpa::op_counts());
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_OPCOUNT_HPP
+#define RCPA_OPCOUNT_HPP
+
+#include <cstdio>
+#include <cstring>
+
+namespace rcpa {
+
+// Carries of deeper levels are added to the last slot.
+const int OPCOUNT_MAX_LEVEL = 32;
+
+struct OpCounts {
+    unsigned long long carries[OPCOUNT_MAX_LEVEL];
+    unsigned long long cascade_bytes;
+    unsigned long long ring_updates;
+    unsigned long long swaps;
+    unsigned long long perms;
+};
+
+#ifdef RCPA_OPCOUNT
+const bool OPCOUNT_ENABLED = true;
+#else
+const bool OPCOUNT_ENABLED = false;
+#endif
+
+// Counters of the calling thread.
+inline OpCounts& op_counts() {
+    static thread_local OpCounts counts;
+    return counts;
+}
+
+inline void reset_op_counts() { std::memset(&op_counts(), 0, sizeof(OpCounts)); }
+
+inline unsigned long long total_carries(const OpCounts& c) {
+    unsigned long long sum = 0;
+    for (int i = 0; i < OPCOUNT_MAX_LEVEL; i++) sum += c.carries[i];
+    return sum;
+}
+
+// OPCOUNT, PERMS_EMITTED, <COUNTER>_PER_PERM and CARRIES_L<i> (total carries
+// at level i) lines for a REPORT block.
+inline void write_opcount_report(FILE* out, const OpCounts& c) {
+    if (!OPCOUNT_ENABLED) {
+        fprintf(out, "\nOPCOUNT: off (build with -DRCPA_OPCOUNT)");
+        return;
+    }
+    const double perms = c.perms ? static_cast<double>(c.perms) : 1.0;
+    fprintf(out, "\nOPCOUNT: on");
+    fprintf(out, "\nPERMS_EMITTED: %llu", c.perms);
+    fprintf(out, "\nCARRIES_PER_PERM: %.6f", total_carries(c) / perms);
+    fprintf(out, "\nCASCADE_BYTES_PER_PERM: %.6f", c.cascade_bytes / perms);
+    fprintf(out, "\nRING_UPDATES_PER_PERM: %.6f", c.ring_updates / perms);
+    fprintf(out, "\nSWAPS_PER_PERM: %.6f", c.swaps / perms);
+    for (int i = 0; i < OPCOUNT_MAX_LEVEL; i++) {
+        if (c.carries[i] != 0) fprintf(out, "\nCARRIES_L%d: %llu", i, c.carries[i]);
+    }
+}
+
+}  // namespace rcpa
+
+#ifdef RCPA_OPCOUNT
+#define RCPA_COUNT_OP(field, amount) (::rcpa::op_counts().field += static_cast<unsigned long long>(amount))
+#define RCPA_COUNT_CARRY(level) \
+    (::rcpa::op_counts().carries[(level) < ::rcpa::OPCOUNT_MAX_LEVEL ? (level) : ::rcpa::OPCOUNT_MAX_LEVEL - 1]++)
+#else
+#define RCPA_COUNT_OP(field, amount) ((void)0)
+#define RCPA_COUNT_CARRY(level) ((void)0)
+#endif
+
+#endif  // RCPA_OPCOUNT_HPP
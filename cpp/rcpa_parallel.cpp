@@ -0,0 +1,157 @@
+/**
+ * @file rcpa_parallel.cpp
+ * @brief Multi-threaded Ring-Cascade-Permutation-Algorithm scaling benchmark
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Runs the sharded RCPA (rcpa_parallel.hpp) with 1, 2, 4, ... worker threads up
+ * to the requested maximum (default: all cores) and prints one REPORT block per
+ * thread count. Each worker pins itself to its own core. --verify adds one
+ * run at max_threads that checks every permutation is generated exactly once
+ * (rcpa_coverage.hpp) and exits with status 1 otherwise. --numa spreads the
+ * workers over the NUMA nodes (rcpa_numa.hpp) and adds one line per node with
+ * its workers and permutations.
+ *
+ * Build: g++ -O3 -std=c++17 -march=native cpp/rcpa_parallel.cpp -o rcpa_parallel -pthread
+ * Usage: ./rcpa_parallel <n> [max_threads] [--verify] [--numa]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <map>
+#include <vector>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_parallel.hpp"
+
+// Order-independent checksum, so every thread count must report the same value.
+struct RingChecksum {
+    int n = 0;
+    unsigned long long sum = 0;
+    unsigned long long rings = 0;
+
+    void operator()(const int* ring) {
+        sum += static_cast<unsigned long long>(ring[0] * n + ring[n - 1]);
+        rings++;
+    }
+};
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const char* positional[2] = { NULL, NULL };
+    int n_positional = 0;
+    bool verify = false;
+    bool numa = false;
+    for (int a = 1; a < argc; a++) {
+        if (std::strcmp(argv[a], "--verify") == 0) verify = true;
+        else if (std::strcmp(argv[a], "--numa") == 0) numa = true;
+        else if (n_positional < 2) positional[n_positional++] = argv[a];
+    }
+    if (n_positional < 1) {
+        fprintf(stderr, "Usage: %s <n> [max_threads] [--verify] [--numa]\n", argv[0]);
+        return 1;
+    }
+    int n_val = std::atoi(positional[0]);
+    if (n_val <= 3) {
+        fprintf(stderr, "Error: n must be greater than 3 for RCPA logic.\n");
+        return 1;
+    }
+    if (verify && n_val > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports n <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    unsigned max_threads = std::thread::hardware_concurrency();
+    if (n_positional >= 2) max_threads = static_cast<unsigned>(std::atoi(positional[1]));
+    if (max_threads == 0) max_threads = 1;
+
+    std::vector<unsigned> thread_counts;
+    for (unsigned t = 1; t < max_threads; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(max_threads);
+
+    const unsigned long long total_perms = rcpa::factorial(n_val);
+    RingChecksum proto;
+    proto.n = n_val;
+    double base_time = 0.0;
+
+    rcpa::ParallelOptions opt;
+    opt.numa = numa;
+    for (unsigned threads : thread_counts) {
+        opt.threads = threads;
+        auto start_point = std::chrono::high_resolution_clock::now();
+        std::vector<RingChecksum> parts = rcpa::parallel_for_each_ring_with<rcpa::DynamicGenerator<int> >(n_val, proto, opt);
+        auto end_point = std::chrono::high_resolution_clock::now();
+        double duration = std::chrono::duration<double>(end_point - start_point).count();
+        if (threads == 1) base_time = duration;
+
+        unsigned long long checksum = 0, rings = 0;
+        for (const RingChecksum& p : parts) {
+            checksum += p.sum;
+            rings += p.rings;
+        }
+        if (rings * static_cast<unsigned long long>(n_val) != total_perms) {
+            fprintf(stderr, "Error: %u threads covered %llu of %llu permutations.\n",
+                    threads, rings * n_val, total_perms);
+            return 1;
+        }
+
+        // --- Standardized Report Output ---
+        printf("\nREPORT_START");
+        printf("\nALGORITHM: rcpa_parallel");
+        printf("\nN_VALUE: %d", n_val);
+        printf("\nTHREADS: %u", threads);
+        printf("\nSHARD_DEPTH: %d", rcpa::plan_shards(n_val, threads).depth);
+        printf("\nEXECUTION_TIME: %lf", duration);
+        printf("\nSPEED: %.2f", (total_perms / duration) / 1e9);
+        printf("\nSPEEDUP: %.2f", base_time / duration);
+        printf("\nCHECKSUM: %llu", checksum);
+        if (numa) {
+            // Worker w ran on slots[w]; its generator and visitor lived on that node.
+            const std::vector<rcpa::CpuSlot> slots = rcpa::parallel_worker_slots(threads, true);
+            std::map<int, std::pair<unsigned, unsigned long long> > nodes;  // workers, perms
+            for (size_t w = 0; w < parts.size(); w++) {
+                nodes[slots[w].node].first++;
+                nodes[slots[w].node].second += parts[w].rings * n_val;
+            }
+            printf("\nNUMA_NODES: %zu", nodes.size());
+            for (const auto& node : nodes) {
+                printf("\nNODE_%d: workers=%u perms=%llu", node.first, node.second.first, node.second.second);
+            }
+        }
+        printf("\nREPORT_END\n");
+    }
+
+    if (verify) {
+        auto start_point = std::chrono::high_resolution_clock::now();
+        rcpa::ShardedCoverage seen(n_val, max_threads);
+        std::vector<rcpa::RingCoverage<int> > parts =
+            rcpa::parallel_for_each_ring(n_val, max_threads, rcpa::RingCoverage<int>(&seen));
+        unsigned long long visited = 0, duplicates = 0;
+        for (rcpa::RingCoverage<int>& p : parts) {
+            p.finish();
+            visited += p.visited;
+            duplicates += p.duplicates;
+        }
+        rcpa::CoverageResult r = seen.result(visited, duplicates);
+        auto end_point = std::chrono::high_resolution_clock::now();
+        double duration = std::chrono::duration<double>(end_point - start_point).count();
+
+        // --- Standardized Report Output ---
+        printf("\nREPORT_START");
+        printf("\nALGORITHM: rcpa_parallel_verify");
+        printf("\nN_VALUE: %d", n_val);
+        printf("\nTHREADS: %u", max_threads);
+        printf("\nEXECUTION_TIME: %lf", duration);
+        printf("\nSPEED: %.2f", (total_perms / duration) / 1e9);
+        printf("\nVISITED: %llu", r.visited);
+        printf("\nMISSING: %llu", r.missing);
+        printf("\nDUPLICATES: %llu", r.duplicates);
+        printf("\nVERIFY: %s", r.pass() ? "PASS" : "FAIL");
+        printf("\nREPORT_END\n");
+        if (!r.pass()) return 1;
+    }
+
+    return 0;
+}
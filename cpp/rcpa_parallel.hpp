@@ -0,0 +1,191 @@
+/**
+ * @file    rcpa_parallel.hpp
+ * @brief   Multi-threaded RCPA: C[] prefix shards on a work-stealing thread pool.
+ * @author  YUSHENG-HU
+ * @details
+ * Every assignment of the top counters C[1..k] roots an independent subtree
+ * of D rows, so the prefix space is split into (k+1)! shards. Each worker owns
+ * a private generator (its own C[] and D_flat) and a private copy of the
+ * visitor; nothing is shared on the hot path.
+ *
+ * Scheduling: every worker starts with a contiguous range of shard indices.
+ * It pops shards from the front of its own range and, once empty, steals the
+ * upper half of the largest remaining range of another worker.
+ *
+ * Placement: worker w runs on core w by default; with `numa` the workers are
+ * spread over the NUMA nodes (rcpa_numa.hpp). Each worker builds its
+ * generator after pinning, so its C/D rows are first-touched on its node.
+ * parallel_worker_slots() tells the caller which node each result came from.
+ *
+ * Usage:
+ *   auto parts = rcpa::parallel_for_each_ring(n, threads, Checksum());
+ *   // merge parts[0 .. threads-1]
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_PARALLEL_HPP
+#define RCPA_PARALLEL_HPP
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rcpa.hpp"
+#include "rcpa_numa.hpp"
+
+namespace rcpa {
+
+// --- Shard Planning ---
+
+struct ShardPlan {
+    int depth;                  // counters C[1..depth] are fixed per shard
+    unsigned long long shards;  // (depth + 1)!
+};
+
+// Smallest prefix depth giving at least `per_thread` shards per worker, so
+// stealing can even out the tail. Capped at N-3 (one ring block per shard).
+inline ShardPlan plan_shards(int n, unsigned threads, unsigned per_thread = 64) {
+    const unsigned long long wanted = static_cast<unsigned long long>(threads) * per_thread;
+    int depth = 0;
+    while (depth < n - 3 && shard_count(depth) < wanted) depth++;
+    ShardPlan plan = { depth, shard_count(depth) };
+    return plan;
+}
+
+// --- Work-Stealing Range Pool ---
+
+class ShardPool {
+public:
+    ShardPool(unsigned workers, unsigned long long count) : queues_(workers) {
+        for (unsigned w = 0; w < workers; w++) {
+            queues_[w].begin = count * w / workers;
+            queues_[w].end = count * (w + 1) / workers;
+        }
+    }
+
+    // Next shard for `worker`; false once every range is drained.
+    bool next(unsigned worker, unsigned long long& shard) {
+        if (pop(queues_[worker], shard)) return true;
+        while (steal(worker)) {
+            if (pop(queues_[worker], shard)) return true;
+        }
+        return false;
+    }
+
+private:
+    struct alignas(64) Range {
+        std::mutex lock;
+        unsigned long long begin = 0;
+        unsigned long long end = 0;
+    };
+
+    static bool pop(Range& r, unsigned long long& shard) {
+        std::lock_guard<std::mutex> guard(r.lock);
+        if (r.begin >= r.end) return false;
+        shard = r.begin++;
+        return true;
+    }
+
+    // Move the upper half of the fullest victim range into our own range.
+    bool steal(unsigned thief) {
+        for (;;) {
+            unsigned victim = thief;
+            unsigned long long best = 0;
+            for (unsigned w = 0; w < queues_.size(); w++) {
+                if (w == thief) continue;
+                std::lock_guard<std::mutex> guard(queues_[w].lock);
+                unsigned long long left = queues_[w].end - queues_[w].begin;
+                if (left > best) { best = left; victim = w; }
+            }
+            if (victim == thief) return false;
+
+            Range& v = queues_[victim];
+            unsigned long long lo, hi;
+            {
+                std::lock_guard<std::mutex> guard(v.lock);
+                unsigned long long left = v.end - v.begin;
+                if (left == 0) continue;  // drained meanwhile, rescan
+                hi = v.end;
+                lo = v.end - (left + 1) / 2;
+                v.end = lo;
+            }
+            std::lock_guard<std::mutex> guard(queues_[thief].lock);
+            queues_[thief].begin = lo;
+            queues_[thief].end = hi;
+            return true;
+        }
+    }
+
+    std::vector<Range> queues_;
+};
+
+// --- Parallel Drivers ---
+
+struct ParallelOptions {
+    unsigned threads = 0;       // 0 = std::thread::hardware_concurrency()
+    unsigned per_thread = 64;   // target shards per worker
+    bool pin = true;            // pin worker w to core w
+    bool numa = false;          // spread the workers over the NUMA nodes instead
+};
+
+// CPU and node of each of `threads` workers (0 = all cores): with `numa`
+// spread over the nodes, otherwise worker w on core w mod cores.
+inline std::vector<CpuSlot> parallel_worker_slots(unsigned threads, bool numa) {
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    if (threads == 0) threads = cores;
+    const NumaTopology topo = read_numa_topology();
+    if (numa) return place_workers(topo, threads, PLACE_SPREAD);
+    std::vector<CpuSlot> slots(threads);
+    for (unsigned w = 0; w < threads; w++) {
+        slots[w].cpu = w % cores;
+        slots[w].node = topo.node_of(slots[w].cpu);
+    }
+    return slots;
+}
+
+// Runs visit(const value_type* ring) over all ring states with one visitor copy per
+// worker; returns the worker copies so the caller can merge their results.
+template <class Gen, class Visitor>
+std::vector<Visitor> parallel_for_each_ring_with(int n, const Visitor& proto,
+                                                 ParallelOptions opt = ParallelOptions()) {
+    const std::vector<CpuSlot> slots = parallel_worker_slots(opt.threads, opt.numa);
+    const unsigned threads = static_cast<unsigned>(slots.size());
+
+    const ShardPlan plan = plan_shards(n, threads, opt.per_thread);
+    ShardPool pool(threads, plan.shards);
+    std::vector<Visitor> results(threads, proto);
+    std::vector<std::thread> workers;
+    workers.reserve(threads);
+
+    for (unsigned w = 0; w < threads; w++) {
+        workers.emplace_back([&, w]() {
+            if (opt.pin) pin_thread_to_core(slots[w].cpu);
+            // Generator state is built on the worker thread (first touch);
+            // the visitor runs on a local copy to keep worker results off
+            // shared cache lines.
+            Gen gen(n);
+            Visitor visit(proto);
+            unsigned long long shard;
+            while (pool.next(w, shard)) {
+                gen.for_each_ring_in_shard(plan.depth, shard, visit);
+            }
+            results[w] = visit;
+        });
+    }
+    for (auto& t : workers) t.join();
+    return results;
+}
+
+template <typename T = int, class Visitor>
+std::vector<Visitor> parallel_for_each_ring(int n, unsigned threads, const Visitor& proto) {
+    ParallelOptions opt;
+    opt.threads = threads;
+    return parallel_for_each_ring_with<DynamicGenerator<T> >(n, proto, opt);
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_PARALLEL_HPP
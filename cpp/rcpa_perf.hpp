@@ -0,0 +1,212 @@
+/**
+ * @file    rcpa_perf.hpp
+ * @brief   Hardware performance counters (perf_event_open) around a run.
+ * @author  YUSHENG-HU
+ * @details
+ * Wall time alone cannot say whether the cascade memcpy, the carry loop or
+ * the ring updates limit a run on a given core. PerfCounters opens one
+ * counter per event for the calling thread, user space only:
+ *
+ *   cycles, instructions, branch misses, L1D read misses, L1D write accesses
+ *
+ * Each event is opened on its own, so an event the CPU or the kernel does
+ * not offer is simply reported as unavailable; if none can be opened (no
+ * PMU in a VM, perf_event_paranoid > 2, not Linux) the report says why and
+ * the run itself is unaffected. Counts are scaled by time_enabled /
+ * time_running when the kernel multiplexes counters.
+ *
+ * write_perf_report() adds the counts per permutation and per outer
+ * iteration to a REPORT block. For the cascade an outer iteration is one
+ * ring block of N(N-1) permutations, (N-2)! in a full run.
+ *
+ *   rcpa::PerfCounters perf;
+ *   perf.open();
+ *   perf.start();  gen.for_each_ring(visit);  perf.stop();
+ *   rcpa::write_perf_report(stdout, perf, rcpa::factorial(n), rcpa::cascade_iterations(n));
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_PERF_HPP
+#define RCPA_PERF_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+enum PerfEvent {
+    PERF_CYCLES = 0,
+    PERF_INSTRUCTIONS,
+    PERF_BRANCH_MISSES,
+    PERF_L1D_MISSES,
+    PERF_L1D_STORES,
+    PERF_EVENT_COUNT
+};
+
+// Report key of each event.
+inline const char* perf_event_name(int e) {
+    static const char* const names[PERF_EVENT_COUNT] = {
+        "CYCLES", "INSTRUCTIONS", "BRANCH_MISSES", "L1D_MISSES", "L1D_STORES"
+    };
+    return names[e];
+}
+
+class PerfCounters {
+public:
+    PerfCounters() : opened_(0) {
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            fd_[e] = -1;
+            value_[e] = 0;
+        }
+        std::strcpy(error_, "not opened");
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+    ~PerfCounters() { close(); }
+
+    // Opens every event that is available; false if none is.
+    bool open() {
+        close();
+#if defined(__linux__)
+        const uint64_t l1d = PERF_COUNT_HW_CACHE_L1D;
+        const uint32_t types[PERF_EVENT_COUNT] = {
+            PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HW_CACHE
+        };
+        const uint64_t configs[PERF_EVENT_COUNT] = {
+            PERF_COUNT_HW_CPU_CYCLES,
+            PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_BRANCH_MISSES,
+            l1d | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            l1d | (PERF_COUNT_HW_CACHE_OP_WRITE << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16)
+        };
+        int first_errno = 0;
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            fd_[e] = open_event(types[e], configs[e]);
+            if (fd_[e] >= 0) opened_++;
+            else if (first_errno == 0) first_errno = errno;
+        }
+        if (opened_ == 0) {
+            std::snprintf(error_, sizeof(error_), "perf_event_open: %s", std::strerror(first_errno));
+            return false;
+        }
+        error_[0] = '\0';
+        return true;
+#else
+        std::strcpy(error_, "perf_event_open needs Linux");
+        return false;
+#endif
+    }
+
+    void close() {
+#if defined(__linux__)
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (fd_[e] >= 0) ::close(fd_[e]);
+            fd_[e] = -1;
+        }
+#endif
+        opened_ = 0;
+    }
+
+    // Resets and enables the open counters.
+    void start() {
+#if defined(__linux__)
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (fd_[e] < 0) continue;
+            ioctl(fd_[e], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_[e], PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Disables the counters and reads the (scaled) counts.
+    void stop() {
+#if defined(__linux__)
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            if (fd_[e] >= 0) ioctl(fd_[e], PERF_EVENT_IOC_DISABLE, 0);
+        }
+        for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+            value_[e] = 0;
+            if (fd_[e] < 0) continue;
+            uint64_t buf[3];  // value, time_enabled, time_running
+            if (read(fd_[e], buf, sizeof(buf)) != static_cast<ssize_t>(sizeof(buf))) continue;
+            if (buf[2] != 0 && buf[2] < buf[1]) {
+                value_[e] = static_cast<unsigned long long>(static_cast<double>(buf[0]) * buf[1] / buf[2]);
+            } else {
+                value_[e] = buf[0];
+            }
+        }
+#endif
+    }
+
+    bool any() const { return opened_ > 0; }
+    bool available(int e) const { return fd_[e] >= 0; }
+    unsigned long long value(int e) const { return value_[e]; }
+    const char* error() const { return error_; }
+
+private:
+#if defined(__linux__)
+    static int open_event(uint32_t type, uint64_t config) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    int fd_[PERF_EVENT_COUNT];
+    unsigned long long value_[PERF_EVENT_COUNT];
+    int opened_;
+    char error_[96];
+};
+
+// PERF, IPC and <EVENT>_PER_PERM / <EVENT>_PER_ITER lines for a run of
+// `perms` permutations in `iterations` outer iterations; unavailable events
+// print "n/a".
+inline void write_perf_report(FILE* out, const PerfCounters& perf, unsigned long long perms,
+                              unsigned long long iterations) {
+    if (!perf.any()) {
+        fprintf(out, "\nPERF: unavailable (%s)", perf.error());
+        return;
+    }
+    fprintf(out, "\nPERF: on");
+    if (perf.available(PERF_CYCLES) && perf.available(PERF_INSTRUCTIONS) && perf.value(PERF_CYCLES) != 0) {
+        fprintf(out, "\nIPC: %.3f", static_cast<double>(perf.value(PERF_INSTRUCTIONS)) / perf.value(PERF_CYCLES));
+    }
+    for (int e = 0; e < PERF_EVENT_COUNT; e++) {
+        if (!perf.available(e)) {
+            fprintf(out, "\n%s_PER_PERM: n/a", perf_event_name(e));
+            fprintf(out, "\n%s_PER_ITER: n/a", perf_event_name(e));
+            continue;
+        }
+        fprintf(out, "\n%s_PER_PERM: %.4f", perf_event_name(e), static_cast<double>(perf.value(e)) / perms);
+        fprintf(out, "\n%s_PER_ITER: %.2f", perf_event_name(e), static_cast<double>(perf.value(e)) / iterations);
+    }
+}
+
+// Outer cascade iterations of a full run: one per ring block of N(N-1)
+// permutations.
+inline unsigned long long cascade_iterations(int n) { return factorial(n - 2); }
+
+}  // namespace rcpa
+
+#endif  // RCPA_PERF_HPP
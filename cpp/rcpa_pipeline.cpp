@@ -0,0 +1,174 @@
+/**
+ * @file rcpa_pipeline.cpp
+ * @brief Generator/consumer pipeline benchmark with a synthetic scoring consumer
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Scores every permutation with an O(N) weighted sum (repeated --work times
+ * to model heavier consumers), first inline in the cascade loop on one core,
+ * then through the pipeline of rcpa_pipeline.hpp with the given producer and
+ * consumer counts. Both REPORT blocks must show the same checksum. The
+ * pipeline report adds the throughput, stalls and waiting time of each stage.
+ * --numa gives every NUMA node its own block pool and places each stage on
+ * the node of its pool (rcpa_numa.hpp); the per-thread lines show the node.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_pipeline.cpp -o rcpa_pipeline -pthread
+ * Usage: ./rcpa_pipeline <n> [--producers=P] [--consumers=C] [--blocks=B]
+ *                        [--block-rings=R] [--work=K] [--no-inline] [--numa]
+ *   defaults: P = 1, C = cores - 1 (at least 1), B = 4 per thread,
+ *             R = 4096 ring states, K = 1
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "rcpa_pipeline.hpp"
+
+// Weighted position sum of every permutation; order-independent, so the
+// inline and pipelined runs must agree.
+struct Score {
+    int n = 0;
+    int work = 1;
+    unsigned long long sum = 0;
+
+    RCPA_INLINE void perm(const uint8_t* p) {
+        unsigned long long s = 0;
+        for (int r = 0; r < work; r++) {
+            for (int t = 0; t < n; t++) s += static_cast<unsigned long long>(t + 1 + r) * p[t];
+        }
+        sum += s;
+    }
+
+    // Inline: one ring state from the cascade loop.
+    void operator()(const uint8_t* ring) {
+        for (int h = 0; h < n; h++) perm(ring + h);
+    }
+
+    // Pipelined: one block from the queue.
+    void operator()(const rcpa::RingBlock<uint8_t>& block) {
+        for (unsigned k = 0; k < block.count; k++) (*this)(block.ring(k));
+    }
+};
+
+void print_stage(const char* name, const std::vector<rcpa::StageStats>& stages) {
+    unsigned long long perms = 0, blocks = 0, stalls = 0;
+    double busy = 0.0, wait = 0.0;
+    for (const rcpa::StageStats& s : stages) {
+        perms += s.perms;
+        blocks += s.blocks;
+        stalls += s.stalls;
+        busy += s.seconds - s.wait_seconds;
+        wait += s.wait_seconds;
+    }
+    printf("\n%s_BLOCKS: %llu", name, blocks);
+    printf("\n%s_STALLS: %llu", name, stalls);
+    printf("\n%s_WAIT_TIME: %lf", name, wait);
+    // Permutations per busy thread-second: what the stage could sustain unblocked.
+    printf("\n%s_SPEED: %.2f", name, busy > 0 ? (perms / busy) / 1e9 : 0.0);
+    for (size_t k = 0; k < stages.size(); k++) {
+        printf("\n%s_%zu: node=%d cpu=%u perms=%llu time=%lf wait=%lf", name, k, stages[k].node, stages[k].cpu,
+               stages[k].perms, stages[k].seconds, stages[k].wait_seconds);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    unsigned cores = std::thread::hardware_concurrency();
+    if (cores == 0) cores = 1;
+    rcpa::PipelineOptions opt;
+    opt.producers = 1;
+    opt.consumers = cores > 1 ? cores - 1 : 1;
+    int work = 1;
+    bool run_inline = true;
+    const char* n_arg = NULL;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--producers=", 12) == 0) opt.producers = std::atoi(argv[a] + 12);
+        else if (std::strncmp(argv[a], "--consumers=", 12) == 0) opt.consumers = std::atoi(argv[a] + 12);
+        else if (std::strncmp(argv[a], "--blocks=", 9) == 0) opt.blocks = std::atoi(argv[a] + 9);
+        else if (std::strncmp(argv[a], "--block-rings=", 14) == 0) opt.block_rings = std::atoi(argv[a] + 14);
+        else if (std::strncmp(argv[a], "--work=", 7) == 0) work = std::atoi(argv[a] + 7);
+        else if (std::strcmp(argv[a], "--no-inline") == 0) run_inline = false;
+        else if (std::strcmp(argv[a], "--numa") == 0) opt.numa = true;
+        else n_arg = argv[a];
+    }
+    if (n_arg == NULL) {
+        fprintf(stderr, "Usage: %s <n> [--producers=P] [--consumers=C] [--blocks=B] [--block-rings=R]"
+                        " [--work=K] [--no-inline] [--numa]\n", argv[0]);
+        return 1;
+    }
+    const int n_val = std::atoi(n_arg);
+    if (n_val <= 3) {
+        fprintf(stderr, "Error: n must be greater than 3 for RCPA logic.\n");
+        return 1;
+    }
+    if (opt.producers == 0 || opt.consumers == 0 || opt.block_rings == 0 || work <= 0) {
+        fprintf(stderr, "Error: producers, consumers, block-rings and work must be positive.\n");
+        return 1;
+    }
+
+    const unsigned long long total_perms = rcpa::factorial(n_val);
+    Score proto;
+    proto.n = n_val;
+    proto.work = work;
+    unsigned long long inline_checksum = 0;
+
+    if (run_inline) {
+        rcpa::pin_thread_to_core(0);
+        auto start_point = std::chrono::high_resolution_clock::now();
+        rcpa::DynamicGenerator<uint8_t> generator(n_val);
+        Score score(proto);
+        generator.for_each_ring(score);
+        auto end_point = std::chrono::high_resolution_clock::now();
+        double duration = std::chrono::duration<double>(end_point - start_point).count();
+        inline_checksum = score.sum;
+
+        // --- Standardized Report Output ---
+        printf("\nREPORT_START");
+        printf("\nALGORITHM: rcpa_inline_consumer");
+        printf("\nN_VALUE: %d", n_val);
+        printf("\nWORK: %d", work);
+        printf("\nEXECUTION_TIME: %lf", duration);
+        printf("\nSPEED: %.2f", (total_perms / duration) / 1e9);
+        printf("\nCHECKSUM: %llu", inline_checksum);
+        printf("\nREPORT_END\n");
+    }
+
+    rcpa::PipelineStats stats;
+    std::vector<Score> parts = rcpa::pipeline_for_each_block<uint8_t>(n_val, opt, proto, &stats);
+    unsigned long long checksum = 0, consumed = 0;
+    for (const Score& p : parts) checksum += p.sum;
+    for (const rcpa::StageStats& s : stats.consumers) consumed += s.perms;
+    if (consumed != total_perms) {
+        fprintf(stderr, "Error: the pipeline consumed %llu of %llu permutations.\n", consumed, total_perms);
+        return 1;
+    }
+
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_pipeline");
+    printf("\nN_VALUE: %d", n_val);
+    printf("\nWORK: %d", work);
+    printf("\nPRODUCERS: %u", opt.producers);
+    printf("\nCONSUMERS: %u", opt.consumers);
+    printf("\nBLOCKS: %u", stats.blocks);
+    printf("\nBLOCK_RINGS: %u", opt.block_rings);
+    printf("\nBLOCK_POOLS: %u", stats.groups);
+    printf("\nEXECUTION_TIME: %lf", stats.seconds);
+    printf("\nSPEED: %.2f", (total_perms / stats.seconds) / 1e9);
+    printf("\nCHECKSUM: %llu", checksum);
+    print_stage("PRODUCER", stats.producers);
+    print_stage("CONSUMER", stats.consumers);
+    printf("\nREPORT_END\n");
+
+    if (run_inline && checksum != inline_checksum) {
+        fprintf(stderr, "Error: pipeline checksum %llu differs from inline checksum %llu.\n", checksum,
+                inline_checksum);
+        return 1;
+    }
+    return 0;
+}
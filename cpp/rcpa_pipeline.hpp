@@ -0,0 +1,407 @@
+/**
+ * @file    rcpa_pipeline.hpp
+ * @brief   Producer/consumer pipeline: generator threads fill ring-window blocks, consumer threads drain them.
+ * @author  YUSHENG-HU
+ * @details
+ * A real consumer (scoring, filtering, output) costs far more per permutation
+ * than the cascade. Run inline, it holds the generator back; run here, the two
+ * stages get their own threads and scale separately.
+ *
+ *   - Blocks   : `blocks` preallocated buffers of `block_rings` ring states.
+ *                A ring state is copied as its 2N-1 entries, so all N windows
+ *                of it stay readable (ring + 0 ... ring + N-1).
+ *   - Queues   : two lock-free bounded MPMC queues of block ids (Vyukov's
+ *                sequence-number ring): `free` and `full`. With one producer
+ *                and one consumer they behave as SPSC queues (no CAS retries).
+ *   - Producers: pull C-prefix shards from the work-stealing pool of
+ *                rcpa_parallel.hpp, take a free block, fill it and push it
+ *                to `full`. No free block means the consumers are behind:
+ *                the producer waits (back-pressure).
+ *   - Consumers: pop full blocks, call consume(const RingBlock<T>&) on their
+ *                own copy of the consumer and return the block to `free`.
+ *
+ * Blocks are recycled; after setup the pipeline does not allocate. Per-thread
+ * statistics (blocks, permutations, busy and waiting time, stalls) show which
+ * stage limits the run.
+ *
+ * With `numa` (rcpa_numa.hpp) the pipeline is split into one group per NUMA
+ * node (at most one per producer and per consumer): each group has its own
+ * blocks, first-touched on its node, and its own queues, and its producers
+ * and consumers run on that node, so blocks never cross a socket.
+ *
+ * Usage:
+ *   rcpa::PipelineOptions opt;
+ *   opt.producers = 2;
+ *   opt.consumers = 6;
+ *   rcpa::PipelineStats stats;
+ *   auto parts = rcpa::pipeline_for_each_block<uint8_t>(n, opt, Score(), &stats);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_PIPELINE_HPP
+#define RCPA_PIPELINE_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "rcpa.hpp"
+#include "rcpa_numa.hpp"
+#include "rcpa_parallel.hpp"
+
+namespace rcpa {
+
+// --- Lock-Free Bounded Queue ---
+
+// Bounded MPMC queue of block ids. Every cell carries a sequence number: a
+// cell is free for the producer of position p when seq == p and holds a value
+// for the consumer of position p when seq == p + 1. Capacity is a power of two.
+class BlockQueue {
+public:
+    explicit BlockQueue(unsigned capacity) {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (size_t k = 0; k < size; k++) cells_[k].seq.store(k, std::memory_order_relaxed);
+        head_.store(0, std::memory_order_relaxed);
+        tail_.store(0, std::memory_order_relaxed);
+    }
+
+    bool try_push(uint32_t value) {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // full
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool try_pop(uint32_t& value) {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t seq = cell.seq.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.seq.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // empty
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> seq;
+        uint32_t value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+};
+
+// --- Blocks and Statistics ---
+
+// `count` ring states, `stride` entries apart; ring(k) + 0 ... ring(k) + n-1
+// are the N permutations of ring state k.
+template <typename T>
+struct RingBlock {
+    const T* data;
+    int n;
+    int stride;
+    unsigned count;
+
+    const T* ring(unsigned k) const { return data + static_cast<size_t>(k) * stride; }
+    unsigned long long perms() const { return static_cast<unsigned long long>(count) * n; }
+};
+
+struct PipelineOptions {
+    unsigned producers = 1;
+    unsigned consumers = 1;
+    unsigned blocks = 0;          // preallocated blocks; 0 = 4 per thread
+    unsigned block_rings = 4096;  // ring states per block
+    unsigned per_thread = 64;     // target shards per producer
+    bool pin = true;              // producers on cores 0.., consumers after them
+    bool numa = false;            // one block pool per node, stages placed on it
+};
+
+struct StageStats {
+    unsigned long long blocks = 0;
+    unsigned long long perms = 0;
+    unsigned long long stalls = 0;  // waits for a free (producer) or full (consumer) block
+    double seconds = 0.0;           // thread run time
+    double wait_seconds = 0.0;      // part of it spent in stalls
+    unsigned cpu = 0;               // where the thread was placed
+    int node = 0;
+};
+
+struct PipelineStats {
+    std::vector<StageStats> producers;
+    std::vector<StageStats> consumers;
+    double seconds = 0.0;
+    unsigned blocks = 0;  // over all groups
+    unsigned groups = 1;  // block pools (NUMA nodes in use)
+};
+
+namespace detail {
+
+inline void pipeline_relax(unsigned spins) {
+    if (spins < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// Producer visitor: copies each ring state into the current block and
+// hands full blocks to the consumers.
+template <typename T>
+struct BlockFiller {
+    int n;
+    int stride;
+    unsigned block_rings;
+    T* arena;
+    unsigned* counts;
+    BlockQueue* free_blocks;
+    BlockQueue* full_blocks;
+    StageStats* stats;
+    uint32_t id;
+    T* out;
+    unsigned count;
+
+    void acquire() {
+        if (!free_blocks->try_pop(id)) {
+            auto start = std::chrono::steady_clock::now();
+            unsigned spins = 0;
+            while (!free_blocks->try_pop(id)) pipeline_relax(spins++);
+            stats->stalls++;
+            stats->wait_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        out = arena + static_cast<size_t>(id) * block_rings * stride;
+        count = 0;
+    }
+
+    void publish() {
+        counts[id] = count;
+        stats->blocks++;
+        stats->perms += static_cast<unsigned long long>(count) * n;
+        unsigned spins = 0;
+        while (!full_blocks->try_push(id)) pipeline_relax(spins++);  // cannot stay full: capacity >= blocks
+    }
+
+    RCPA_INLINE void operator()(const T* ring) {
+        std::memcpy(out, ring, static_cast<size_t>(2 * n - 1) * sizeof(T));
+        out += stride;
+        if (++count == block_rings) {
+            publish();
+            acquire();
+        }
+    }
+};
+
+}  // namespace detail
+
+// --- Pipeline Driver ---
+
+namespace detail {
+
+// Blocks and queues shared by the producers and consumers of one node.
+template <typename T>
+struct BlockGroup {
+    BlockGroup(unsigned blocks, size_t block_size, unsigned producers)
+        : arena(new T[blocks * block_size]), counts(blocks, 0), free_blocks(blocks), full_blocks(blocks),
+          producers_left(producers) {}
+
+    std::unique_ptr<T[]> arena;  // untouched until first_touch()
+    std::vector<unsigned> counts;
+    BlockQueue free_blocks;
+    BlockQueue full_blocks;
+    std::atomic<unsigned> producers_left;
+};
+
+}  // namespace detail
+
+// Runs all ring states of Gen(n) through `producers` generator threads and
+// `consumers` consumer threads; consume(const RingBlock<value_type>&) runs on
+// one copy of `proto` per consumer thread. Returns the consumer copies so the
+// caller can merge their results.
+template <class Gen, class Consumer>
+std::vector<Consumer> pipeline_for_each_block_with(int n, const Consumer& proto, PipelineOptions opt,
+                                                   PipelineStats* stats = nullptr) {
+    typedef typename Gen::value_type T;
+    if (opt.producers == 0) opt.producers = 1;
+    if (opt.consumers == 0) opt.consumers = 1;
+    if (opt.block_rings == 0) opt.block_rings = 1;
+    if (opt.blocks == 0) opt.blocks = 4 * (opt.producers + opt.consumers);
+
+    // Producer p and consumer c belong to group p mod groups / c mod groups,
+    // one group per node in use; without `numa` there is a single group.
+    const NumaTopology topo = read_numa_topology();
+    unsigned groups = 1;
+    if (opt.numa) {
+        groups = static_cast<unsigned>(topo.nodes.size());
+        groups = std::min(groups, std::min(opt.producers, opt.consumers));
+    }
+    std::vector<StageStats> producer_stats(opt.producers), consumer_stats(opt.consumers);
+    const std::vector<CpuSlot> compact = place_workers(topo, opt.producers + opt.consumers, PLACE_COMPACT);
+    for (unsigned p = 0; p < opt.producers; p++) {
+        StageStats& s = producer_stats[p];
+        if (opt.numa) {
+            const NumaNode& node = topo.nodes[p % groups];
+            s.cpu = node.cpus[(p / groups) % node.cpus.size()];
+        } else {
+            s.cpu = compact[p].cpu;
+        }
+        s.node = topo.node_of(s.cpu);
+    }
+    for (unsigned c = 0; c < opt.consumers; c++) {
+        StageStats& s = consumer_stats[c];
+        if (opt.numa) {
+            // After the group's producers on the same node.
+            const unsigned g = c % groups;
+            const unsigned local_producers = (opt.producers - g + groups - 1) / groups;
+            const NumaNode& node = topo.nodes[g];
+            s.cpu = node.cpus[(local_producers + c / groups) % node.cpus.size()];
+        } else {
+            s.cpu = compact[opt.producers + c].cpu;
+        }
+        s.node = topo.node_of(s.cpu);
+    }
+
+    // Every producer holds one block while it waits for another.
+    const int stride = 2 * n;
+    const size_t block_size = static_cast<size_t>(opt.block_rings) * stride;
+    std::vector<std::unique_ptr<detail::BlockGroup<T> > > pools;
+    unsigned total_blocks = 0;
+    for (unsigned g = 0; g < groups; g++) {
+        const unsigned local_producers = (opt.producers - g + groups - 1) / groups;
+        const unsigned blocks = std::max(opt.blocks / groups, local_producers + 1);
+        pools.emplace_back(new detail::BlockGroup<T>(blocks, block_size, local_producers));
+        detail::BlockGroup<T>& pool = *pools.back();
+        if (opt.numa) first_touch(pool.arena.get(), blocks * block_size * sizeof(T), producer_stats[g].cpu);
+        else std::memset(pool.arena.get(), 0, blocks * block_size * sizeof(T));
+        for (uint32_t b = 0; b < blocks; b++) pool.free_blocks.try_push(b);
+        total_blocks += blocks;
+    }
+
+    const ShardPlan plan = plan_shards(n, opt.producers, opt.per_thread);
+    ShardPool shards(opt.producers, plan.shards);
+    std::vector<Consumer> results(opt.consumers, proto);
+    std::vector<std::thread> threads;
+    threads.reserve(opt.producers + opt.consumers);
+    auto start = std::chrono::steady_clock::now();
+
+    for (unsigned p = 0; p < opt.producers; p++) {
+        threads.emplace_back([&, p]() {
+            StageStats local = producer_stats[p];
+            if (opt.pin) pin_thread_to_core(local.cpu);
+            auto begin = std::chrono::steady_clock::now();
+            detail::BlockGroup<T>& pool = *pools[p % groups];
+            Gen gen(n);  // built after pinning: C/D rows on the local node
+            detail::BlockFiller<T> fill = { n, stride, opt.block_rings, pool.arena.get(), pool.counts.data(),
+                                            &pool.free_blocks, &pool.full_blocks, &local, 0, nullptr, 0 };
+            fill.acquire();
+            unsigned long long shard;
+            while (shards.next(p, shard)) gen.for_each_ring_in_shard(plan.depth, shard, fill);
+            if (fill.count > 0) {
+                fill.publish();
+            } else {
+                unsigned spins = 0;
+                while (!pool.free_blocks.try_push(fill.id)) detail::pipeline_relax(spins++);
+            }
+            local.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            producer_stats[p] = local;
+            pool.producers_left.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    for (unsigned c = 0; c < opt.consumers; c++) {
+        threads.emplace_back([&, c]() {
+            StageStats local = consumer_stats[c];
+            if (opt.pin) pin_thread_to_core(local.cpu);
+            auto begin = std::chrono::steady_clock::now();
+            detail::BlockGroup<T>& pool = *pools[c % groups];
+            Consumer consume(proto);
+            uint32_t id;
+            for (;;) {
+                if (!pool.full_blocks.try_pop(id)) {
+                    // Empty: either the producers are behind or they are done.
+                    auto wait = std::chrono::steady_clock::now();
+                    unsigned spins = 0;
+                    bool done = false;
+                    while (!pool.full_blocks.try_pop(id)) {
+                        if (pool.producers_left.load(std::memory_order_acquire) == 0) {
+                            // Last blocks were pushed before the count dropped.
+                            if (!pool.full_blocks.try_pop(id)) done = true;
+                            break;
+                        }
+                        detail::pipeline_relax(spins++);
+                    }
+                    local.stalls++;
+                    local.wait_seconds +=
+                        std::chrono::duration<double>(std::chrono::steady_clock::now() - wait).count();
+                    if (done) break;
+                }
+                RingBlock<T> block = { pool.arena.get() + static_cast<size_t>(id) * block_size, n, stride,
+                                       pool.counts[id] };
+                consume(static_cast<const RingBlock<T>&>(block));
+                local.blocks++;
+                local.perms += block.perms();
+                unsigned spins = 0;
+                while (!pool.free_blocks.try_push(id)) detail::pipeline_relax(spins++);
+            }
+            local.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            consumer_stats[c] = local;
+            results[c] = consume;
+        });
+    }
+    for (auto& t : threads) t.join();
+
+    if (stats) {
+        stats->producers = producer_stats;
+        stats->consumers = consumer_stats;
+        stats->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        stats->blocks = total_blocks;
+        stats->groups = groups;
+    }
+    return results;
+}
+
+template <typename T = uint8_t, class Consumer>
+std::vector<Consumer> pipeline_for_each_block(int n, const PipelineOptions& opt, const Consumer& proto,
+                                              PipelineStats* stats = nullptr) {
+    return pipeline_for_each_block_with<DynamicGenerator<T> >(n, proto, opt, stats);
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_PIPELINE_HPP
@@ -0,0 +1,148 @@
+/**
+ * @file    rcpa_pp.hpp
+ * @brief   PP + ring generator (ppa_rcpa.cpp) as a reusable header.
+ * @author  YUSHENG-HU
+ * @details
+ * The Position-Pure (PP) algorithm generates the (N-2)! base permutations in
+ * place on D[0..N-3]; each base is expanded by a ring burst (rcpa_simd.hpp)
+ * into N-1 ring states of N windows each, for N! permutations in total.
+ *
+ * rcpa::DynamicPPRingGenerator takes N at runtime: it instantiates
+ * PPRingGenerator<N> for every N in [PP_MIN_N, PP_MAX_N] and picks one
+ * through the table of rcpa::dispatch_size(), so each N keeps its unrolled
+ * burst and constant offsets without a build per N.
+ *
+ * Usage:
+ *   rcpa::PPRingGenerator<15, uint8_t> gen;              // build-selected burst
+ *   gen.for_each_ring([&](const uint8_t* ring) { ... });
+ *   rcpa::DynamicPPRingGenerator<uint8_t> any(n);        // 4 <= n <= 20
+ *   any.for_each_ring([&](const uint8_t* ring) { ... });
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_PP_HPP
+#define RCPA_PP_HPP
+
+#include <type_traits>
+
+#include "rcpa_dispatch.hpp"
+#include "rcpa_simd.hpp"
+
+namespace rcpa {
+
+template <int N, typename T = int, class Burst = DefaultBurst>
+class PPRingGenerator {
+    static_assert(N > 3, "PP + ring logic requires N > 3");
+
+public:
+    typedef T value_type;
+
+    explicit PPRingGenerator(int = N) {}
+
+    static constexpr int size() { return N; }
+    unsigned long long count() const { return factorial(N); }
+
+    // Calls visit(const T* ring) once per ring state; the N windows
+    // ring + 0 ... ring + N-1 are the permutations of that state.
+    template <class Visitor>
+    void for_each_ring(Visitor&& visit) {
+        const int pp_n = N - 2;
+        std::memset(D, 0, sizeof(D));
+        for (int k = 0; k < pp_n; k++) C[k] = 0;
+        for (int k = 0; k < pp_n; k++) D[k] = static_cast<T>(k);
+        int i = 0;
+
+        // Main Permutation Generation Loop
+        while (C[0] < 1) {
+            RCPA_COUNT_OP(swaps, pp_n - 1 - i);
+            for (; i < pp_n - 1; ++i) {
+                D[i] = D[C[i]];
+                D[C[i]] = static_cast<T>(i);
+            }
+
+            for (int ii = 0; ii < pp_n; ii++) {
+                D[pp_n - 1] = D[ii];
+                D[ii] = static_cast<T>(pp_n - 1);
+                Burst::template run<N>(D, visit);
+                D[ii] = D[pp_n - 1];
+            }
+            RCPA_COUNT_OP(swaps, pp_n + 1);
+
+            D[C[pp_n - 2]] = D[pp_n - 2];
+            C[pp_n - 2]++;
+            for (i = pp_n - 2; (i > 0) && (C[i] > i); i--) {
+                RCPA_COUNT_CARRY(i);
+                RCPA_COUNT_OP(swaps, 1);
+                C[i] = 0;
+                C[i - 1]++;
+                D[C[i - 1] - 1] = D[i - 1];
+            }
+        }
+    }
+
+    // Calls visit(const T* perm) once for each of the N! permutations.
+    template <class Visitor>
+    void for_each(Visitor&& visit) {
+        for_each_ring([&](const T* ring) {
+            for (int h = 0; h < N; h++) visit(ring + h);
+        });
+    }
+
+private:
+    alignas(64) T D[3 * N + RCPA_BURST_PAD];
+    int C[N - 2];
+};
+
+// N range of DynamicPPRingGenerator (20! is the last factorial in 64 bits).
+const int PP_MIN_N = 4;
+const int PP_MAX_N = 20;
+
+template <typename T = int, class Burst = DefaultBurst>
+class DynamicPPRingGenerator {
+public:
+    typedef T value_type;
+
+    explicit DynamicPPRingGenerator(int n) : n_(n) {}
+
+    static bool supports(int n) { return n >= PP_MIN_N && n <= PP_MAX_N; }
+
+    int size() const { return n_; }
+    unsigned long long count() const { return factorial(n_); }
+
+    // Calls visit(const T* ring) once per ring state; false (nothing
+    // visited) if size() is outside [PP_MIN_N, PP_MAX_N].
+    template <class Visitor>
+    bool for_each_ring(Visitor&& visit) {
+        RingRun<typename std::remove_reference<Visitor>::type> run = { &visit };
+        return dispatch_size<PP_MIN_N, PP_MAX_N>(n_, run);
+    }
+
+    // Calls visit(const T* perm) once for each of the N! permutations.
+    template <class Visitor>
+    bool for_each(Visitor&& visit) {
+        const int n = n_;
+        return for_each_ring([&](const T* ring) {
+            for (int h = 0; h < n; h++) visit(ring + h);
+        });
+    }
+
+private:
+    template <class Visitor>
+    struct RingRun {
+        Visitor* visit;
+
+        template <int N>
+        void run() {
+            PPRingGenerator<N, T, Burst> generator;
+            generator.for_each_ring(*visit);
+        }
+    };
+
+    int n_;
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_PP_HPP
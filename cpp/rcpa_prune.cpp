@@ -0,0 +1,156 @@
+/**
+ * @file rcpa_prune.cpp
+ * @brief Branch-and-bound on cascade rows vs filtering all N! permutations
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Constrained search example: a set of seeded cyclic-order constraints
+ * "a, b, c appear in this cyclic order" (round-robin schedules, seatings).
+ * Cascade row j fixes the cyclic order of 0..j for its whole subtree, so a
+ * constraint is decided as soon as the row of its largest element is built.
+ *   - filter : for_each_ring() over all states, every constraint per state
+ *   - pruned : for_each_ring_pruned(), each row checks the constraints whose
+ *              largest element it introduces and skips failing subtrees
+ * Both must count the same matches with the same checksum.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_prune.cpp -o rcpa_prune
+ * Usage: ./rcpa_prune <n> [constraints]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <chrono>
+#include <vector>
+
+#include "rcpa.hpp"
+
+struct Triple {
+    int a, b, c;  // required cyclic order a -> b -> c
+};
+
+// True if a, b, c appear in cyclic order within seq[0..len-1].
+inline bool cyclic_order(const uint8_t* seq, int len, const Triple& t) {
+    int pa = 0, pb = 0, pc = 0;
+    for (int p = 0; p < len; p++) {
+        if (seq[p] == t.a) pa = p;
+        else if (seq[p] == t.b) pb = p;
+        else if (seq[p] == t.c) pc = p;
+    }
+    return (pb - pa + len) % len < (pc - pa + len) % len;
+}
+
+// Constraints grouped by their largest element (the row that decides them).
+struct Constraints {
+    int n;
+    std::vector<std::vector<Triple> > by_level;
+
+    bool holds(int level, const uint8_t* seq, int len) const {
+        const std::vector<Triple>& list = by_level[level];
+        for (size_t t = 0; t < list.size(); t++) {
+            if (!cyclic_order(seq, len, list[t])) return false;
+        }
+        return true;
+    }
+};
+
+struct MatchCount {
+    unsigned long long rings;
+    unsigned long long checksum;
+};
+
+// Rows 1 .. N-2: skip the subtree when a constraint decided here fails.
+struct RowPrune {
+    const Constraints* cs;
+
+    bool operator()(int j, const uint8_t* row) const { return !cs->holds(j, row, j + 1); }
+};
+
+// Ring states: constraints on N-1 (plus all of them in filter mode).
+struct RingFilter {
+    const Constraints* cs;
+    int from_level;
+    MatchCount* out;
+
+    void operator()(const uint8_t* ring) const {
+        const int n = cs->n;
+        for (int level = from_level; level < n; level++) {
+            if (!cs->holds(level, ring, n)) return;
+        }
+        out->rings++;
+        out->checksum += static_cast<unsigned long long>(ring[0] * n + ring[n - 1]);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <n> [constraints]\n", argv[0]);
+        return 1;
+    }
+    int n_val = std::atoi(argv[1]);
+    if (n_val <= 3 || n_val > 20) {
+        fprintf(stderr, "Error: n must be in 4..20 for the pruning benchmark.\n");
+        return 1;
+    }
+    int m_val = (argc > 2) ? std::atoi(argv[2]) : n_val;
+
+    // Seeded constraints over distinct elements; the largest one picks the level.
+    Constraints cs;
+    cs.n = n_val;
+    cs.by_level.resize(static_cast<size_t>(n_val));
+    unsigned long long seed = 0x2545F4914F6CDD1Dull;
+    for (int k = 0; k < m_val; k++) {
+        int v[3];
+        for (int t = 0; t < 3; t++) {
+            bool fresh;
+            do {
+                seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+                v[t] = static_cast<int>((seed >> 33) % static_cast<unsigned long long>(n_val));
+                fresh = true;
+                for (int u = 0; u < t; u++) fresh = fresh && (v[u] != v[t]);
+            } while (!fresh);
+        }
+        Triple tr = { v[0], v[1], v[2] };
+        int top = v[0];
+        if (v[1] > top) top = v[1];
+        if (v[2] > top) top = v[2];
+        cs.by_level[static_cast<size_t>(top)].push_back(tr);
+    }
+
+    rcpa::DynamicGenerator<uint8_t> generator(n_val);
+
+    MatchCount filtered = { 0, 0 };
+    RingFilter filter_all = { &cs, 0, &filtered };
+    auto start_point = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring(filter_all);
+    auto end_point = std::chrono::high_resolution_clock::now();
+    double filter_time = std::chrono::duration<double>(end_point - start_point).count();
+
+    MatchCount pruned = { 0, 0 };
+    RowPrune prune = { &cs };
+    RingFilter filter_last = { &cs, n_val - 1, &pruned };
+    start_point = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring_pruned(prune, filter_last);
+    end_point = std::chrono::high_resolution_clock::now();
+    double pruned_time = std::chrono::duration<double>(end_point - start_point).count();
+
+    if (pruned.rings != filtered.rings || pruned.checksum != filtered.checksum) {
+        fprintf(stderr, "Error: pruned search found %llu ring states, filter found %llu.\n",
+                pruned.rings, filtered.rings);
+        return 1;
+    }
+
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_prune");
+    printf("\nN_VALUE: %d", n_val);
+    printf("\nCONSTRAINTS: %d", m_val);
+    printf("\nMATCHES: %llu", filtered.rings * static_cast<unsigned long long>(n_val));
+    printf("\nFILTER_TIME: %lf", filter_time);
+    printf("\nPRUNED_TIME: %lf", pruned_time);
+    printf("\nSPEEDUP: %.2f", filter_time / pruned_time);
+    printf("\nCHECKSUM: %llu", pruned.checksum);
+    printf("\nREPORT_END\n");
+    return 0;
+}
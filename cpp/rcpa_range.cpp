@@ -0,0 +1,164 @@
+/**
+ * @file rcpa_range.cpp
+ * @brief Iterator overhead: rcpa::permutations(n) range vs the raw visitor loop
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Sums an O(1) checksum over all N! permutations on one pinned core, through
+ * the visitor (DynamicGenerator::for_each) and with a range-for over
+ * rcpa::permutations(n) (rcpa_range.hpp), alternating the two --repeat times
+ * and reporting the median time of each. Both REPORT blocks must show the
+ * same checksum and count; the range block adds its overhead relative to the
+ * visitor loop. A third block takes the first --take permutations that
+ * start with 0 through std::views::filter | take and stops the generator there.
+ *
+ * Build: g++ -O3 -std=c++20 cpp/rcpa_range.cpp -o rcpa_range -pthread
+ * Usage: ./rcpa_range <n> [--repeat=R] [--take=K]
+ *   R : timed runs of each loop (default 5)
+ *   K : permutations taken in the early-exit run (default 1000)
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#include <ranges>
+#include <vector>
+
+#include "rcpa_numa.hpp"
+#include "rcpa_range.hpp"
+
+struct RunResult {
+    double duration;
+    unsigned long long checksum;
+    unsigned long long perms;
+};
+
+RunResult run_visitor(int n) {
+    const int tail = n - 1;
+    RunResult r = { 0.0, 0, 0 };
+    auto start_point = std::chrono::high_resolution_clock::now();
+    rcpa::DynamicGenerator<uint8_t> generator(n);
+    unsigned long long sum = 0, perms = 0;
+    generator.for_each([&](const uint8_t* perm) {
+        sum += static_cast<unsigned long long>(perm[0] * n + perm[tail]);
+        perms++;
+    });
+    auto end_point = std::chrono::high_resolution_clock::now();
+    r.duration = std::chrono::duration<double>(end_point - start_point).count();
+    r.checksum = sum;
+    r.perms = perms;
+    return r;
+}
+
+RunResult run_range(int n) {
+    const int tail = n - 1;
+    RunResult r = { 0.0, 0, 0 };
+    auto start_point = std::chrono::high_resolution_clock::now();
+    unsigned long long sum = 0, perms = 0;
+    for (std::span<const uint8_t> perm : rcpa::permutations<uint8_t>(n)) {
+        sum += static_cast<unsigned long long>(perm[0] * n + perm[tail]);
+        perms++;
+    }
+    auto end_point = std::chrono::high_resolution_clock::now();
+    r.duration = std::chrono::duration<double>(end_point - start_point).count();
+    r.checksum = sum;
+    r.perms = perms;
+    return r;
+}
+
+// Result of the run with the median time.
+RunResult median_run(std::vector<RunResult> runs) {
+    std::sort(runs.begin(), runs.end(),
+              [](const RunResult& a, const RunResult& b) { return a.duration < b.duration; });
+    return runs[runs.size() / 2];
+}
+
+void print_report(const char* name, int n, const RunResult& r) {
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: %s", name);
+    printf("\nN_VALUE: %d", n);
+    printf("\nPERMUTATIONS: %llu", r.perms);
+    printf("\nEXECUTION_TIME: %lf", r.duration);
+    printf("\nSPEED: %.2f", r.duration > 0 ? (r.perms / r.duration) / 1e9 : 0.0);
+    printf("\nCHECKSUM: %llu", r.checksum);
+}
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const char* n_arg = NULL;
+    long long take = 1000;
+    int repeat = 5;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--take=", 7) == 0) take = std::atoll(argv[a] + 7);
+        else if (std::strncmp(argv[a], "--repeat=", 9) == 0) repeat = std::atoi(argv[a] + 9);
+        else n_arg = argv[a];
+    }
+    if (n_arg == NULL) {
+        fprintf(stderr, "Usage: %s <n> [--repeat=R] [--take=K]\n", argv[0]);
+        return 1;
+    }
+    const int n_val = std::atoi(n_arg);
+    if (n_val <= 3 || n_val > 20) {
+        fprintf(stderr, "Error: n must be in [4, 20].\n");
+        return 1;
+    }
+    if (take <= 0 || repeat <= 0) {
+        fprintf(stderr, "Error: take and repeat must be positive.\n");
+        return 1;
+    }
+    rcpa::pin_thread_to_core(0);
+    const int tail = n_val - 1;
+
+    // Alternate the two loops so drift on the host hits both alike.
+    std::vector<RunResult> visitor_runs, range_runs;
+    for (int r = 0; r < repeat; r++) {
+        visitor_runs.push_back(run_visitor(n_val));
+        range_runs.push_back(run_range(n_val));
+    }
+    const RunResult visitor = median_run(visitor_runs);
+    const RunResult range = median_run(range_runs);
+
+    // Early exit through <ranges> adaptors
+    RunResult first = { 0.0, 0, 0 };
+    {
+        auto start_point = std::chrono::high_resolution_clock::now();
+        auto view = rcpa::permutations<uint8_t>(n_val)
+                  | std::views::filter([](std::span<const uint8_t> p) { return p[0] == 0; })
+                  | std::views::take(take);
+        for (std::span<const uint8_t> perm : view) {
+            first.checksum += static_cast<unsigned long long>(perm[0] * n_val + perm[tail]);
+            first.perms++;
+        }
+        auto end_point = std::chrono::high_resolution_clock::now();
+        first.duration = std::chrono::duration<double>(end_point - start_point).count();
+    }
+
+    // --- Standardized Report Output ---
+    print_report("rcpa_visitor", n_val, visitor);
+    printf("\nREPORT_END\n");
+    print_report("rcpa_range", n_val, range);
+    printf("\nREPEATS: %d", repeat);
+    printf("\nOVERHEAD: %.2f%%", visitor.duration > 0 ? (range.duration / visitor.duration - 1.0) * 100.0 : 0.0);
+    printf("\nREPORT_END\n");
+    print_report("rcpa_range_filter_take", n_val, first);
+    printf("\nTAKE: %lld", take);
+    printf("\nREPORT_END\n");
+
+    const unsigned long long total_perms = rcpa::factorial(n_val);
+    if (visitor.perms != total_perms || range.perms != total_perms || range.checksum != visitor.checksum) {
+        fprintf(stderr, "Error: range emitted %llu permutations (checksum %llu), visitor %llu (checksum %llu).\n",
+                range.perms, range.checksum, visitor.perms, visitor.checksum);
+        return 1;
+    }
+    const unsigned long long starts_with_zero = total_perms / n_val;
+    const unsigned long long want = static_cast<unsigned long long>(take) < starts_with_zero
+                                        ? static_cast<unsigned long long>(take) : starts_with_zero;
+    if (first.perms != want) {
+        fprintf(stderr, "Error: filter | take returned %llu of %llu permutations.\n", first.perms, want);
+        return 1;
+    }
+    return 0;
+}
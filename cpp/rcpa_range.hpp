@@ -0,0 +1,113 @@
+/**
+ * @file    rcpa_range.hpp
+ * @brief   Lazy C++20 range over the RCPA sequence (requires -std=c++20).
+ * @author  YUSHENG-HU
+ * @details
+ * rcpa::permutations(n) is an input view whose elements are std::span<const T>
+ * views of the N! permutations in RCPA order. Nothing is copied or allocated
+ * per element: the iterator walks the N windows of the current ring state in
+ * the 3N ring row, and only when they are used up refills the row with the
+ * next ring state (BasicGenerator::next_ring()). One refill serves N
+ * permutations, so the per-element cost is a pointer increment and a compare.
+ *
+ * A span is valid until the iterator moves past its ring state; copy it (or
+ * use rank()) to keep a permutation. The view owns its generator and is
+ * single-pass: begin() rewinds to the first permutation.
+ *
+ * It composes with <ranges>; taking a prefix stops the generator early:
+ *   for (auto perm : rcpa::permutations(n)) score(perm.data());
+ *   auto hits = rcpa::permutations<uint8_t>(n)
+ *             | std::views::filter([](auto p) { return p[0] == 0; })
+ *             | std::views::take(10);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_RANGE_HPP
+#define RCPA_RANGE_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+
+#include "rcpa.hpp"
+
+namespace rcpa {
+
+template <class Gen>
+class PermutationView : public std::ranges::view_interface<PermutationView<Gen> > {
+public:
+    typedef typename Gen::value_type T;
+
+    class iterator {
+    public:
+        using iterator_concept = std::input_iterator_tag;
+        using value_type = std::span<const T>;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+
+        std::span<const T> operator*() const { return std::span<const T>(cur_, n_); }
+
+        RCPA_INLINE iterator& operator++() {
+            if (++cur_ == stop_) [[unlikely]] refill();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) { return it.cur_ == nullptr; }
+
+    private:
+        friend class PermutationView;
+
+        explicit iterator(Gen* gen) : gen_(gen), n_(static_cast<size_t>(gen->size())) {
+            gen_->seek(0);
+            rings_left_ = factorial(gen->size() - 1);
+            cur_ = gen_->ring();
+            stop_ = cur_ + n_;
+            RCPA_COUNT_OP(perms, n_);
+        }
+
+        // Windows of this ring state used up: load the next one, or end.
+        RCPA_INLINE void refill() {
+            if (--rings_left_ == 0) {
+                cur_ = nullptr;
+                return;
+            }
+            gen_->next_ring();
+            cur_ = gen_->ring();
+            stop_ = cur_ + n_;
+            RCPA_COUNT_OP(perms, n_);
+        }
+
+        Gen* gen_ = nullptr;
+        const T* cur_ = nullptr;   // current window; nullptr at the end
+        const T* stop_ = nullptr;  // one past the last window of the ring state
+        size_t n_ = 0;
+        unsigned long long rings_left_ = 0;
+    };
+
+    // n > 3 (as for the generator); n! must fit in 64 bits.
+    explicit PermutationView(int n) : gen_(new Gen(n)) {}
+
+    iterator begin() { return iterator(gen_.get()); }
+    std::default_sentinel_t end() const { return std::default_sentinel; }
+
+    unsigned long long count() const { return gen_->count(); }
+
+private:
+    std::unique_ptr<Gen> gen_;
+};
+
+// All N! permutations of 0..n-1 in RCPA order as a lazy input view.
+template <typename T = int>
+PermutationView<DynamicGenerator<T> > permutations(int n) {
+    return PermutationView<DynamicGenerator<T> >(n);
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_RANGE_HPP
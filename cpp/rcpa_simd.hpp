@@ -0,0 +1,245 @@
+/**
+ * @file    rcpa_simd.hpp
+ * @brief   Ring burst kernels (scalar, AVX2, AVX-512) for the PP + ring generator.
+ * @author  YUSHENG-HU
+ * @details
+ * A burst turns one base permutation P of 0..N-3 (D[0..N-3]) into the N-1
+ * ring states of [P, N-2, N-1]. Ring state r is passed to the visitor as a
+ * pointer `ring` whose N windows ring + 0 ... ring + N-1 are permutations.
+ *
+ *   - BurstScalar : ppa_rcpa.cpp logic. Mirrors P to OFFSET_B2/OFFSET_B3 with
+ *                   memcpy, then walks N-1 forward by one swap per state.
+ *   - BurstAvx2   : uint8_t, N <= 16. Ring state r is kept in a register;
+ *                   one VPSHUFB writes it out doubled (2N-1 bytes, one
+ *                   32-byte store) and one VPSHUFB steps it to state r + 1.
+ *   - BurstAvx512 : uint8_t, N <= 32. The register holds state r already
+ *                   doubled: one 64-byte store and one VPERMB (AVX512-VBMI)
+ *                   per state.
+ * No mirror copies or swap chains remain in the SIMD kernels.
+ *
+ * The SIMD kernels fall back to BurstScalar for other element types or
+ * larger N. rcpa::DefaultBurst is the widest kernel the build enables
+ * (-mavx2 / -mavx512vbmi or -march=native); rcpa::BurstFor<isa> is the
+ * kernel for a runtime-dispatched variant (rcpa_dispatch.hpp). With GCC/Clang
+ * on x86 the SIMD kernels carry their own target attribute, so they are
+ * available in any build but may only be inlined into a matching variant.
+ *
+ * Buffer contract: D has room for 3*N + RCPA_BURST_PAD elements.
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_SIMD_HPP
+#define RCPA_SIMD_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "rcpa.hpp"
+#include "rcpa_dispatch.hpp"
+
+#if RCPA_HAVE_DISPATCH || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// SIMD bursts compiled in: all of them when they can carry their own target
+// attribute, otherwise whatever the build flags enable.
+#if RCPA_HAVE_DISPATCH
+#define RCPA_BURST_AVX2 1
+#define RCPA_BURST_AVX512 1
+#define RCPA_TARGET_BURST_AVX2 __attribute__((target("avx2")))
+#define RCPA_TARGET_BURST_AVX512 __attribute__((target("avx512bw,avx512vbmi")))
+#else
+#if defined(__AVX2__)
+#define RCPA_BURST_AVX2 1
+#else
+#define RCPA_BURST_AVX2 0
+#endif
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__)
+#define RCPA_BURST_AVX512 1
+#else
+#define RCPA_BURST_AVX512 0
+#endif
+#define RCPA_TARGET_BURST_AVX2
+#define RCPA_TARGET_BURST_AVX512
+#endif
+
+// always_inline only when the build flags already enable the ISA: a caller
+// compiled without it cannot inline the kernel. Dispatched variants inline
+// it through `flatten` instead.
+#if defined(__AVX2__)
+#define RCPA_INLINE_BURST_AVX2 RCPA_INLINE
+#else
+#define RCPA_INLINE_BURST_AVX2 inline
+#endif
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__)
+#define RCPA_INLINE_BURST_AVX512 RCPA_INLINE
+#else
+#define RCPA_INLINE_BURST_AVX512 inline
+#endif
+
+// Slack after the 3N buffer so full-width vector loads/stores stay in bounds.
+#define RCPA_BURST_PAD 64
+
+namespace rcpa {
+
+// --- Scalar Burst (ppa_rcpa.cpp) ---
+
+struct BurstScalar {
+    static const char* name() { return "scalar"; }
+
+    template <int N, typename T>
+    static constexpr bool supports() { return true; }
+
+    template <int N, typename T, class Visitor>
+    static RCPA_INLINE void run(T* D, Visitor& visit) {
+        const int OFFSET_B1 = 0;
+        const int OFFSET_B2 = N;
+        const int OFFSET_B3 = N + (N - 1);
+
+        D[N - 2] = static_cast<T>(N - 2);
+        D[N - 1] = static_cast<T>(N - 1);
+        __builtin_memcpy(&D[OFFSET_B2], &D[OFFSET_B1], (N - 1) * sizeof(T));
+        __builtin_memcpy(&D[OFFSET_B3], &D[OFFSET_B1], (N - 1) * sizeof(T));
+
+        RCPA_COUNT_OP(cascade_bytes, 2 * (N - 1) * sizeof(T));
+        RCPA_COUNT_OP(ring_updates, N - 1);
+        RCPA_COUNT_OP(perms, N * (N - 1));
+
+        T* target = &D[N - 1];
+        #pragma GCC unroll 16
+        for (int layer_shift = 0; layer_shift < N - 1; layer_shift++) {
+            visit(static_cast<const T*>(D + layer_shift));
+            // *target always holds N-1 here, so the swap is one copy and
+            // one constant store (the ring update of rcpa.hpp).
+            *target = *(target + 1);
+            *(target + 1) = static_cast<T>(N - 1);
+            target++;
+        }
+    }
+};
+
+// --- Shuffle Tables ---
+
+// Ring state r is T_r = [S[r], ..., S[r-1], N-1] with S = [P, N-2]; state
+// r + 1 is T_r with its first N-1 entries rotated left by one. Both shuffles
+// are fixed per N and built at compile time:
+//   out[t]  : T_r written out doubled (byte t is T_r[t mod N])
+//   step[t] : T_{r+1} from T_r in the same layout
+// For WIDTH 32 (VPSHUFB) step works within each 128-bit lane, which holds
+// T_r in its low N bytes.
+template <int N, int WIDTH>
+struct BurstTables {
+    alignas(64) uint8_t out[WIDTH];
+    alignas(64) uint8_t step[WIDTH];
+
+    constexpr BurstTables() : out(), step() {
+        for (int t = 0; t < WIDTH; t++) {
+            const int u = (WIDTH == 32 ? t % 16 : t) % N;
+            out[t] = static_cast<uint8_t>(t % N);
+            step[t] = static_cast<uint8_t>((u == N - 1) ? N - 1 : (u + 1) % (N - 1));
+        }
+    }
+};
+
+// --- AVX2 Burst ---
+
+struct BurstAvx2 {
+    static const char* name() { return "avx2"; }
+
+    template <int N, typename T>
+    static constexpr bool supports() { return std::is_same<T, uint8_t>::value && N <= 16; }
+
+#if RCPA_BURST_AVX2
+    template <int N, typename T, class Visitor>
+    static RCPA_INLINE_BURST_AVX2 RCPA_TARGET_BURST_AVX2 void run(T* D, Visitor& visit) {
+        if constexpr (!supports<N, T>()) {
+            BurstScalar::run<N>(D, visit);
+        } else {
+            static constexpr BurstTables<N, 32> tables;
+            const __m256i out_ctrl = _mm256_load_si256(reinterpret_cast<const __m256i*>(tables.out));
+            const __m256i step_ctrl = _mm256_load_si256(reinterpret_cast<const __m256i*>(tables.step));
+            D[N - 2] = static_cast<T>(N - 2);
+            D[N - 1] = static_cast<T>(N - 1);
+            // Both 128-bit lanes hold T_r, so VPSHUFB can place any of its
+            // bytes anywhere in the 2N-1 byte output.
+            __m256i state = _mm256_broadcastsi128_si256(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(D)));
+            uint8_t* out = D + N;
+            #pragma GCC unroll 32
+            for (int r = 0; r < N - 1; r++) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_shuffle_epi8(state, out_ctrl));
+                visit(static_cast<const T*>(out));
+                state = _mm256_shuffle_epi8(state, step_ctrl);
+            }
+            RCPA_COUNT_OP(ring_updates, N - 1);
+            RCPA_COUNT_OP(perms, N * (N - 1));
+        }
+    }
+#else
+    template <int N, typename T, class Visitor>
+    static RCPA_INLINE void run(T* D, Visitor& visit) {
+        BurstScalar::run<N>(D, visit);
+    }
+#endif
+};
+
+// --- AVX-512 Burst ---
+
+struct BurstAvx512 {
+    static const char* name() { return "avx512"; }
+
+    template <int N, typename T>
+    static constexpr bool supports() { return std::is_same<T, uint8_t>::value && N <= 32; }
+
+#if RCPA_BURST_AVX512
+    template <int N, typename T, class Visitor>
+    static RCPA_INLINE_BURST_AVX512 RCPA_TARGET_BURST_AVX512 void run(T* D, Visitor& visit) {
+        if constexpr (!supports<N, T>()) {
+            BurstScalar::run<N>(D, visit);
+        } else {
+            static constexpr BurstTables<N, 64> tables;
+            const __m512i out_ctrl = _mm512_load_si512(tables.out);
+            const __m512i step_ctrl = _mm512_load_si512(tables.step);
+            D[N - 2] = static_cast<T>(N - 2);
+            D[N - 1] = static_cast<T>(N - 1);
+            // The maskz form sidesteps GCC's -Wuninitialized on the unmasked
+            // intrinsic; with an all-ones mask it is plain VPERMB.
+            __m512i state = _mm512_maskz_permutexvar_epi8(~0ull, out_ctrl, _mm512_loadu_si512(D));
+            uint8_t* out = D + N;
+            #pragma GCC unroll 32
+            for (int r = 0; r < N - 1; r++) {
+                _mm512_storeu_si512(out, state);
+                visit(static_cast<const T*>(out));
+                state = _mm512_maskz_permutexvar_epi8(~0ull, step_ctrl, state);
+            }
+            RCPA_COUNT_OP(ring_updates, N - 1);
+            RCPA_COUNT_OP(perms, N * (N - 1));
+        }
+    }
+#else
+    template <int N, typename T, class Visitor>
+    static RCPA_INLINE void run(T* D, Visitor& visit) {
+        BurstScalar::run<N>(D, visit);
+    }
+#endif
+};
+
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__)
+typedef BurstAvx512 DefaultBurst;
+#elif defined(__AVX2__)
+typedef BurstAvx2 DefaultBurst;
+#else
+typedef BurstScalar DefaultBurst;
+#endif
+
+// Burst kernel for a dispatched ISA variant (sse4.2 has no burst of its own).
+template <Isa I> struct BurstFor { typedef BurstScalar type; };
+template <> struct BurstFor<Isa::Avx2> { typedef BurstAvx2 type; };
+template <> struct BurstFor<Isa::Avx512> { typedef BurstAvx512 type; };
+
+}  // namespace rcpa
+
+#endif  // RCPA_SIMD_HPP
@@ -0,0 +1,176 @@
+/**
+ * @file    rcpa_superperm.hpp
+ * @brief   Streaming superpermutation from the RCPA ring/cascade structure.
+ * @author  YUSHENG-HU
+ * @details
+ * superpermutation/ring-cascade_superpermutation_generate.py merges the N!
+ * permutations in RCPA order, each time searching for the longest overlap
+ * between the string built so far and the next permutation. In RCPA order
+ * that overlap is fixed by the structure, so no search is needed:
+ *
+ *   next window of the same ring state   : overlap N-1 (1 new symbol)
+ *   first window of the next ring state  : overlap N-2 (2 new symbols)
+ *   first window of a new ring block     : overlap i, where C[i] is the
+ *                                          counter the carry stopped at
+ *                                          (N-i new symbols)
+ *
+ * The symbols appended for one ring state are therefore one contiguous
+ * slice ring[start .. 2N-2] of the doubled ring row, with start = N-2, i or
+ * 0 (the very first permutation). The total is sum_{k=1..N} k! symbols.
+ *
+ * Packed output (".sp4"): a 32-byte SuperpermHeader followed by the symbols,
+ * two per byte, symbol 2k in the low nibble of byte k. N <= 16.
+ *
+ * Usage:
+ *   rcpa::DumpWriter out;  out.open(path, rcpa::superperm_file_bytes(n), opt);
+ *   rcpa::NibbleWriter packed(&out);  packed.header(n, rcpa::superperm_length(n));
+ *   rcpa::SuperpermVisitor<rcpa::NibbleWriter> visit(n, &packed);
+ *   gen.for_each_ring(visit);  packed.finish();  out.close();
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_SUPERPERM_HPP
+#define RCPA_SUPERPERM_HPP
+
+#include <cstdint>
+#include <cstring>
+
+#include "rcpa.hpp"
+#include "rcpa_dump.hpp"
+
+namespace rcpa {
+
+const int SUPERPERM_MAX_N = 16;
+
+// sum_{k=1..n} k!
+inline unsigned long long superperm_length(int n) {
+    unsigned long long f = 1, sum = 0;
+    for (int k = 1; k <= n; k++) {
+        f *= static_cast<unsigned long long>(k);
+        sum += f;
+    }
+    return sum;
+}
+
+// --- Packed File Format ---
+
+struct SuperpermHeader {
+    char magic[8];               // "RCPASP4\0"
+    uint32_t n;
+    uint32_t bits;               // bits per symbol (4)
+    uint64_t length;             // symbols
+    uint64_t reserved;
+};
+
+static_assert(sizeof(SuperpermHeader) == 32, "SuperpermHeader must be 32 bytes");
+
+inline unsigned long long superperm_file_bytes(int n) {
+    return sizeof(SuperpermHeader) + (superperm_length(n) + 1) / 2;
+}
+
+// Packs symbols 0..15 into nibbles through a DumpWriter (little-endian).
+class NibbleWriter {
+public:
+    explicit NibbleWriter(DumpWriter* out) : out_(out), acc_(0), bits_(0), length_(0) {}
+
+    void header(int n, unsigned long long length) {
+        SuperpermHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "RCPASP4", 8);
+        h.n = static_cast<uint32_t>(n);
+        h.bits = 4;
+        h.length = length;
+        std::memcpy(out_->reserve(sizeof(h)), &h, sizeof(h));
+    }
+
+    template <typename T>
+    RCPA_INLINE void put(const T* s, int count) {
+        for (int k = 0; k < count; k++) {
+            acc_ |= static_cast<uint64_t>(s[k]) << bits_;
+            bits_ += 4;
+            if (bits_ == 64) {
+                std::memcpy(out_->reserve(8), &acc_, 8);
+                acc_ = 0;
+                bits_ = 0;
+            }
+        }
+        length_ += static_cast<unsigned long long>(count);
+    }
+
+    // Writes the last partial word (its unused high nibble is 0).
+    void finish() {
+        const int bytes = (bits_ + 7) / 8;
+        if (bytes > 0) std::memcpy(out_->reserve(bytes), &acc_, bytes);
+        acc_ = 0;
+        bits_ = 0;
+    }
+
+    unsigned long long length() const { return length_; }
+
+private:
+    DumpWriter* out_;
+    uint64_t acc_;
+    int bits_;
+    unsigned long long length_;
+};
+
+// Symbol count only.
+struct LengthSink {
+    unsigned long long length = 0;
+
+    template <typename T>
+    RCPA_INLINE void put(const T*, int count) { length += static_cast<unsigned long long>(count); }
+};
+
+// --- Ring Visitor ---
+
+// Appends the new symbols of each ring state to `out` (put(const T*, int)).
+// Must see every ring state of a full for_each_ring() in order: the block
+// carries are tracked with a private copy of the counters C[1..N-3].
+template <class Sink>
+class SuperpermVisitor {
+public:
+    SuperpermVisitor(int n, Sink* out) : n_(n), out_(out), ring_index_(0), first_(true) {
+        for (int j = 0; j < SUPERPERM_MAX_N; j++) C_[j] = 0;
+    }
+
+    template <typename T>
+    RCPA_INLINE void operator()(const T* ring) {
+        int start = n_ - 2;
+        if (ring_index_ == 0) {
+            if (first_) {
+                start = 0;
+                first_ = false;
+            } else {
+                start = next_block();
+            }
+        }
+        out_->put(ring + start, 2 * n_ - 1 - start);
+        if (++ring_index_ == n_ - 1) ring_index_ = 0;
+    }
+
+private:
+    // Same carry as the cascade; returns the counter index it stopped at,
+    // which is the overlap with the last permutation of the previous block.
+    int next_block() {
+        int i = n_ - 3;
+        C_[i]++;
+        while (i > 0 && C_[i] > i) {
+            C_[i] = 0;
+            C_[--i]++;
+        }
+        return i;
+    }
+
+    int n_;
+    Sink* out_;
+    int ring_index_;
+    bool first_;
+    int C_[SUPERPERM_MAX_N];
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_SUPERPERM_HPP
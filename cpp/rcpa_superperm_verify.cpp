@@ -0,0 +1,80 @@
+/**
+ * @file rcpa_superperm_verify.cpp
+ * @brief Checks that a packed superpermutation contains every permutation
+ * @copyright Copyright (c) 2026 [ Yusheng-Hu ]. All rights reserved.
+ * @license Licensed under the MIT License.
+ * @details
+ * Reads a .sp4 file written by rcpa_superperm.cpp and marks every N-wide
+ * window that is a permutation in an N!-bit coverage bitmap
+ * (rcpa_superperm_verify.hpp), chunked across threads. Prints the first
+ * missing permutations and duplicated window offsets, if any, and exits with
+ * status 1 unless all N! permutations were found.
+ *
+ * Build: g++ -O3 -std=c++17 cpp/rcpa_superperm_verify.cpp -o rcpa_superperm_verify -pthread
+ * Usage: ./rcpa_superperm_verify <file.sp4> [--threads=K]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <thread>
+
+#include "rcpa_superperm_verify.hpp"
+
+int main(int argc, char* argv[]) {
+    // --- Parse Command Line Argument ---
+    const char* path = NULL;
+    unsigned threads = std::thread::hardware_concurrency();
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--threads=", 10) == 0) threads = static_cast<unsigned>(std::atoi(argv[a] + 10));
+        else if (path == NULL) path = argv[a];
+    }
+    if (path == NULL) {
+        fprintf(stderr, "Usage: %s <file.sp4> [--threads=K]\n", argv[0]);
+        return 1;
+    }
+    if (threads == 0) threads = 1;
+
+    rcpa::SuperpermFile file;
+    if (!file.open(path)) {
+        fprintf(stderr, "Error: %s is not a packed superpermutation file.\n", path);
+        return 1;
+    }
+    const int n_val = file.n();
+
+    auto start_point = std::chrono::high_resolution_clock::now();
+    rcpa::SuperpermCoverage cov = rcpa::verify_superperm(file, threads);
+    auto end_point = std::chrono::high_resolution_clock::now();
+    double duration = std::chrono::duration<double>(end_point - start_point).count();
+
+    int perm[rcpa::SUPERPERM_MAX_N];
+    for (size_t k = 0; k < cov.first_missing.size(); k++) {
+        rcpa::rotation_unindex(cov.first_missing[k], n_val, perm);
+        printf("MISSING:");
+        for (int t = 0; t < n_val; t++) printf(" %d", perm[t]);
+        printf("\n");
+    }
+    for (size_t k = 0; k < cov.first_duplicates.size(); k++) {
+        printf("DUPLICATE_AT: %llu\n", cov.first_duplicates[k]);
+    }
+
+    // --- Standardized Report Output ---
+    printf("\nREPORT_START");
+    printf("\nALGORITHM: rcpa_superperm_verify");
+    printf("\nN_VALUE: %d", n_val);
+    printf("\nTHREADS: %u", threads);
+    printf("\nLENGTH: %llu", cov.length);
+    printf("\nFORMULA: %llu", rcpa::superperm_length(n_val));
+    printf("\nWINDOWS: %llu", cov.windows);
+    printf("\nPERM_WINDOWS: %llu", cov.perm_windows);
+    printf("\nFULL_RANKS: %llu", cov.rank_full);
+    printf("\nCOVERED: %llu", cov.covered);
+    printf("\nMISSING: %llu", cov.missing);
+    printf("\nDUPLICATES: %llu", cov.duplicates);
+    printf("\nEXECUTION_TIME: %lf", duration);
+    printf("\nSYMBOLS_PER_SEC: %.2f", (cov.length / duration) / 1e9);
+    printf("\nRESULT: %s", cov.missing == 0 ? "PASS" : "FAIL");
+    printf("\nREPORT_END\n");
+    return cov.missing == 0 ? 0 : 1;
+}
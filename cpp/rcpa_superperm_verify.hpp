@@ -0,0 +1,296 @@
+/**
+ * @file    rcpa_superperm_verify.hpp
+ * @brief   Parallel coverage check of packed superpermutation files.
+ * @author  YUSHENG-HU
+ * @details
+ * Slides an N-wide window over a .sp4 file (rcpa_superperm.hpp) and marks
+ * every window that is a permutation in an N!-bit CoverageBitmap. The file
+ * is a superpermutation iff no bit stays clear.
+ *
+ * Window index. A permutation w is identified by the position p of N-1 in
+ * it and by the order of the other N-1 symbols read cyclically after it:
+ *
+ *   index(w) = rank(w[p+1], ..., w[p+N-1]  (mod N)) * N + p
+ *
+ * with rank the Lehmer rank of a permutation of 0..N-2 (rcpa_coverage.hpp).
+ * When the window slides by one and the entering symbol equals the leaving
+ * one, the new window is a rotation of the old: the rank is unchanged and
+ * only p moves.
+ * Whether a window is a permutation at all is decided in O(1) from the last
+ * position of each symbol, so only the first window of each run of
+ * rotations pays the O(N) rank, and most windows of an RCPA
+ * superpermutation are rotations. A symbol >= N (a corrupt file) counts as
+ * a repeat at its own position, so no window holding it is ranked.
+ *
+ * The bits of one run of rotations are adjacent (rank * N + p), so they are
+ * collected in a mask and published with one atomic fetch_or per bitmap
+ * word, a few runs after their word was prefetched. The window range is
+ * split into one chunk per thread; a chunk reads N-1 symbols past its end
+ * so boundary windows are not lost. The fetch_or
+ * results tell each thread which of its bits were already set, so
+ * duplicates are counted exactly once.
+ *
+ *   rcpa::SuperpermFile file;  file.open("sp12.sp4");
+ *   rcpa::SuperpermCoverage cov = rcpa::verify_superperm(file, threads);
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_SUPERPERM_VERIFY_HPP
+#define RCPA_SUPERPERM_VERIFY_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_superperm.hpp"
+
+namespace rcpa {
+
+// --- Packed File Reader (mmap) ---
+
+class SuperpermFile {
+public:
+    SuperpermFile() {}
+    SuperpermFile(const SuperpermFile&) = delete;
+    SuperpermFile& operator=(const SuperpermFile&) = delete;
+    ~SuperpermFile() { close(); }
+
+    bool open(const char* path) {
+        close();
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SuperpermHeader))) {
+            ::close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (p == MAP_FAILED) return false;
+        base_ = static_cast<const uint8_t*>(p);
+        madvise(p, size_, MADV_SEQUENTIAL);
+
+        // Symbols 0..n-1 must fit in `bits` and their N! windows in a coverage
+        // bitmap; `length` symbols must fit in the file (no wrap in the check).
+        std::memcpy(&header_, base_, sizeof(header_));
+        const unsigned long long capacity = 2ull * (size_ - sizeof(SuperpermHeader));
+        const bool valid = std::memcmp(header_.magic, "RCPASP4", 8) == 0 && header_.bits == 4 &&
+                           header_.n >= 4 && header_.n <= (1u << header_.bits) &&
+                           header_.n <= static_cast<uint32_t>(COVERAGE_MAX_N) &&
+                           header_.length >= header_.n && header_.length <= capacity;
+        if (!valid) {
+            close();
+            return false;
+        }
+        data_ = base_ + sizeof(SuperpermHeader);
+        return true;
+    }
+
+    void close() {
+        if (base_ != NULL) munmap(const_cast<uint8_t*>(base_), size_);
+        base_ = NULL;
+        data_ = NULL;
+        size_ = 0;
+    }
+
+    int n() const { return static_cast<int>(header_.n); }
+    unsigned long long length() const { return header_.length; }
+
+    int symbol(unsigned long long k) const { return (data_[k >> 1] >> ((k & 1) * 4)) & 15; }
+
+private:
+    const uint8_t* base_ = NULL;
+    const uint8_t* data_ = NULL;
+    size_t size_ = 0;
+    SuperpermHeader header_;
+};
+
+// --- Parallel Verification ---
+
+struct SuperpermCoverage {
+    int n = 0;
+    unsigned long long length = 0;
+    unsigned long long windows = 0;       // length - n + 1
+    unsigned long long perm_windows = 0;  // windows that are permutations
+    unsigned long long rank_full = 0;     // windows ranked from scratch
+    unsigned long long covered = 0;       // distinct permutations seen
+    unsigned long long missing = 0;       // N! - covered
+    unsigned long long duplicates = 0;    // perm_windows - covered
+    std::vector<unsigned long long> first_missing;     // rotation indices
+    std::vector<unsigned long long> first_duplicates;  // window offsets
+};
+
+namespace detail {
+
+struct SuperpermChunk {
+    unsigned long long perm_windows = 0;
+    unsigned long long rank_full = 0;
+    unsigned long long duplicates = 0;
+    std::vector<unsigned long long> first_duplicates;
+
+    void duplicate(unsigned long long offset, size_t limit) {
+        if (first_duplicates.size() < limit) first_duplicates.push_back(offset);
+        duplicates++;
+    }
+};
+
+// One run of rotations of the same class: the windows at offsets
+// start, start+1, ... have p = p0, p0-1, ... (mod N). Their bits
+// rank_n + p are collected in `pending` and published with one fetch_or
+// per bitmap word instead of one per window.
+struct RotationRun {
+    unsigned long long rank_n = 0;
+    unsigned long long start = 0;
+    int p0 = 0;
+    uint32_t pending = 0;
+
+    void publish(CoverageBitmap& seen, int n, size_t limit, SuperpermChunk& out) const {
+        const uint64_t old = seen.mark_bits(rank_n, pending, n);
+        uint64_t dup = old & pending;
+        while (dup != 0) {
+            const int p = __builtin_ctzll(dup);
+            out.duplicate(start + static_cast<unsigned long long>((p0 - p + n) % n), limit);
+            dup &= dup - 1;
+        }
+    }
+};
+
+// Consecutive runs land in unrelated parts of the bitmap. Runs wait here for
+// DEPTH further runs while their bitmap word is prefetched, so the misses
+// overlap instead of stalling the scan one by one.
+class RunQueue {
+public:
+    static const int DEPTH = 16;
+
+    RunQueue(CoverageBitmap& seen, int n, size_t limit, SuperpermChunk& out)
+        : seen_(seen), n_(n), limit_(limit), out_(out), count_(0) {}
+
+    void push(const RotationRun& run) {
+        if (run.pending == 0) return;
+        RotationRun& slot = runs_[count_ & (DEPTH - 1)];
+        if (count_ >= DEPTH) slot.publish(seen_, n_, limit_, out_);
+        slot = run;
+        seen_.prefetch(run.rank_n);
+        count_++;
+    }
+
+    void drain() {
+        const unsigned long long first = count_ > DEPTH ? count_ - DEPTH : 0;
+        for (unsigned long long k = first; k < count_; k++) runs_[k & (DEPTH - 1)].publish(seen_, n_, limit_, out_);
+        count_ = 0;
+    }
+
+private:
+    CoverageBitmap& seen_;
+    int n_;
+    size_t limit_;
+    SuperpermChunk& out_;
+    unsigned long long count_;
+    RotationRun runs_[DEPTH];
+};
+
+inline void verify_chunk(const SuperpermFile& file, CoverageBitmap& seen, unsigned long long begin,
+                         unsigned long long end, size_t report_limit, SuperpermChunk& out) {
+    const int n = file.n();
+    // Window [s, s+N-1] holds a repeated symbol iff some symbol in it occurred
+    // before at position >= s. `repeat` is the largest such previous position
+    // seen so far; it only grows, so one compare per window decides.
+    long long last[SUPERPERM_MAX_N];
+    for (int t = 0; t < SUPERPERM_MAX_N; t++) last[t] = -1;
+    long long repeat = -1;
+    int hist[2 * SUPERPERM_MAX_N];  // symbols q - 2N + 1 .. q
+    const int mask = 2 * SUPERPERM_MAX_N - 1;
+    int w[SUPERPERM_MAX_N];
+
+    RunQueue queue(seen, n, report_limit, out);
+    RotationRun run;
+    bool prev_perm = false;
+    int p = 0;
+    const long long first = static_cast<long long>(begin);
+    const long long stop = static_cast<long long>(end) + n - 1;
+    for (long long q = first; q < stop; q++) {
+        const int in = file.symbol(static_cast<unsigned long long>(q));
+        if (last[in] > repeat) repeat = last[in];
+        last[in] = q;
+        if (in >= n) repeat = q;
+        hist[q & mask] = in;
+        const long long s = q - n + 1;
+        if (s < first) continue;
+
+        if (repeat < s) {
+            if (prev_perm && in == hist[(q - n) & mask]) {
+                p = (p == 0) ? n - 1 : p - 1;
+            } else {
+                queue.push(run);
+                run.pending = 0;
+                for (int t = 0; t < n; t++) w[t] = hist[(s + t) & mask];
+                run.rank_n = rotation_class(w, n, p) * static_cast<unsigned long long>(n);
+                run.start = static_cast<unsigned long long>(s);
+                run.p0 = p;
+                out.rank_full++;
+            }
+            // A run longer than N repeats itself.
+            const uint32_t bit = 1u << p;
+            if (run.pending & bit) out.duplicate(static_cast<unsigned long long>(s), report_limit);
+            run.pending |= bit;
+            out.perm_windows++;
+            prev_perm = true;
+        } else {
+            prev_perm = false;
+        }
+    }
+    queue.push(run);
+    queue.drain();
+}
+
+}  // namespace detail
+
+inline SuperpermCoverage verify_superperm(const SuperpermFile& file, unsigned threads, size_t report_limit = 8) {
+    SuperpermCoverage r;
+    r.n = file.n();
+    r.length = file.length();
+    r.windows = r.length - static_cast<unsigned long long>(r.n) + 1;
+    CoverageBitmap seen(factorial(r.n));
+
+    if (threads == 0) threads = 1;
+    std::vector<detail::SuperpermChunk> parts(threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        const unsigned long long begin = r.windows * t / threads;
+        const unsigned long long end = r.windows * (t + 1) / threads;
+        pool.emplace_back([&file, &seen, &parts, begin, end, report_limit, t]() {
+            detail::verify_chunk(file, seen, begin, end, report_limit, parts[t]);
+        });
+    }
+    for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+
+    for (unsigned t = 0; t < threads; t++) {
+        r.perm_windows += parts[t].perm_windows;
+        r.rank_full += parts[t].rank_full;
+        r.duplicates += parts[t].duplicates;
+        for (size_t k = 0; k < parts[t].first_duplicates.size() && r.first_duplicates.size() < report_limit; k++) {
+            r.first_duplicates.push_back(parts[t].first_duplicates[k]);
+        }
+    }
+    r.covered = seen.count();
+    r.missing = seen.size() - r.covered;
+    r.first_missing = seen.missing(report_limit);
+    return r;
+}
+
+}  // namespace rcpa
+
+#endif  // RCPA_SUPERPERM_VERIFY_HPP
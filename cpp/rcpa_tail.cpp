@@ -0,0 +1,125 @@
+/**
+ * @file    rcpa_tail.cpp
+ * @brief   Cascade engine vs table-driven tail expansion (rcpa_tail.hpp)
+ * @author  YUSHENG-HU
+ * @details
+ * Runs the full cascade (rcpa.hpp) and TailGenerator with its scalar
+ * expansion and with the expansion of the selected ISA variant, all with the
+ * same visitors. Both the checksum and the opaque consumer are measured, as
+ * in ppa_rcpa_simd.cpp. Matching checksums confirm the tail tables reproduce
+ * the cascade; --verify also checks every engine for exactly-once coverage
+ * (rcpa_coverage.hpp, untimed; RCPA_N <= 14).
+ *
+ * Build: g++ -O3 -std=c++17 -DRCPA_N=13 cpp/rcpa_tail.cpp -o rcpa_tail -pthread
+ * Usage: ./rcpa_tail [--isa=scalar|sse4.2|avx2|avx512] [--verify]
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+
+#include "rcpa_coverage.hpp"
+#include "rcpa_tail.hpp"
+#include "rcpa_parallel.hpp"
+
+#ifndef RCPA_N
+#define RCPA_N 13
+#endif
+
+const int CP_N = RCPA_N;
+
+// Returns false if `verify` found a missing or repeated permutation.
+template <class Gen>
+bool run_engine(const char* engine, const char* expansion, int tail_depth, bool verify) {
+    typedef typename Gen::value_type T;
+    Gen generator;
+    unsigned long long checksum = 0;
+    const unsigned long long total_perms = rcpa::factorial(CP_N);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring([&](const T* ring) {
+        checksum += static_cast<unsigned long long>(ring[0]) * CP_N + ring[CP_N - 1];
+    });
+    auto finish = std::chrono::high_resolution_clock::now();
+    double checksum_time = std::chrono::duration<double>(finish - start).count();
+
+    start = std::chrono::high_resolution_clock::now();
+    generator.for_each_ring([](const T* ring) {
+        __asm__ __volatile__("" : : "r"(ring) : "memory");
+    });
+    finish = std::chrono::high_resolution_clock::now();
+    double opaque_time = std::chrono::duration<double>(finish - start).count();
+
+    // Standardized output for log parsing
+    printf("Engine: %s\n", engine);
+    printf("Expansion: %s\n", expansion);
+    printf("Element Type: uint8_t\n");
+    printf("Tail Levels: %d\n", tail_depth);
+    printf("N: %d\n", CP_N);
+    printf("Total Permutations: %llu\n", total_perms);
+    printf("Time: %.6f\n", checksum_time);
+    printf("Speed: %.2f\n", (total_perms / checksum_time) / 1e9);
+    printf("Opaque Time: %.6f\n", opaque_time);
+    printf("Opaque Speed: %.2f\n", (total_perms / opaque_time) / 1e9);
+
+    // Optional exactly-once check, outside the timed passes
+    bool passed = true;
+    if (verify) {
+        rcpa::ShardedCoverage seen(CP_N);
+        rcpa::RingCoverage<T> cover(&seen);
+        generator.for_each_ring(cover);
+        cover.finish();
+        rcpa::CoverageResult r = seen.result(cover.visited, cover.duplicates);
+        passed = r.pass();
+        printf("Verify: %s (missing %llu, duplicates %llu)\n", passed ? "PASS" : "FAIL", r.missing, r.duplicates);
+    }
+    printf("Checksum: %llu\n\n", checksum);
+    return passed;
+}
+
+// All engines compiled for one ISA variant (see rcpa::dispatch).
+struct TailKernel {
+    bool verify;
+    bool passed;
+
+    template <class Tag>
+    void operator()(Tag) {
+        typedef rcpa::TailGenerator<CP_N, uint8_t, rcpa::Isa::Scalar> ScalarTail;
+        typedef rcpa::TailGenerator<CP_N, uint8_t, Tag::value> IsaTail;
+        passed = run_engine<rcpa::Generator<CP_N, uint8_t> >("cascade", "-", 0, verify);
+        passed &= run_engine<ScalarTail>("tail", "scalar", ScalarTail::tail_depth(), verify);
+        if (Tag::value != rcpa::Isa::Scalar)
+            passed &= run_engine<IsaTail>("tail", rcpa::isa_name(Tag::value), IsaTail::tail_depth(), verify);
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const char* isa_flag = NULL;
+    bool verify = false;
+    for (int a = 1; a < argc; a++) {
+        if (std::strncmp(argv[a], "--isa=", 6) == 0) {
+            isa_flag = argv[a] + 6;
+        } else if (std::strcmp(argv[a], "--verify") == 0) {
+            verify = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--isa=scalar|sse4.2|avx2|avx512] [--verify]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (verify && CP_N > rcpa::COVERAGE_MAX_N) {
+        fprintf(stderr, "Error: --verify supports N <= %d (N! bits of memory).\n", rcpa::COVERAGE_MAX_N);
+        return 1;
+    }
+    rcpa::Isa isa;
+    if (!rcpa::resolve_isa(isa_flag, isa)) return 1;
+
+    rcpa::pin_thread_to_core(0);
+    printf("ISA: %s\n\n", rcpa::isa_name(isa));
+
+    TailKernel kernel = { verify, true };
+    rcpa::dispatch(isa, kernel);
+    return kernel.passed ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+/**
+ * @file    rcpa_tail.hpp
+ * @brief   Table-driven tail expansion: the last K cascade levels as constexpr gathers.
+ * @author  YUSHENG-HU
+ * @details
+ * Below a parent row, the cascade is data independent. Row p+1 of the
+ * cascade (p = N-3-K) holds a sequence of p+2 elements. For every
+ * assignment of the K counters C[p+1 .. N-3], the ring base B (the window of
+ * row N-3 at C[N-3]) is a fixed rearrangement of that sequence plus the
+ * pivots p+2 .. N-3. TailTable<N, K> stores these rearrangements as gather
+ * indices, built at compile time:
+ *
+ *   src = [window of row p at C[p], p+1, p+2, ..., N-3]      (N-2 elements)
+ *   B   = src[idx[b][0]], ..., src[idx[b][N-3]]     for block b of the tail
+ *
+ * TailGenerator runs the counter/carry machinery only for C[1..p]. Each tail
+ * block then costs one table-driven expansion and the N-1 ring updates:
+ *   - scalar / any T : gather B, mirror it with memcpy (BurstScalar)
+ *   - sse4.2 / avx2  : uint8_t, N <= 16: gather B with one PSHUFB
+ *   - avx512         : uint8_t, N <= 21: the whole 3N ring row with VPERMB,
+ *                      so no mirror copies remain
+ * The ISA level is a template parameter (rcpa::BUILD_ISA by default, or
+ * Tag::value inside rcpa::dispatch). The order is the RCPA order of rcpa.hpp.
+ *
+ * With -DRCPA_OPCOUNT the gathers count as cascade bytes (rcpa_opcount.hpp);
+ * carries are counted only for the levels above the tail.
+ *
+ * K is chosen per N (tail_levels<N>()) as the deepest tail whose table stays
+ * within RCPA_TAIL_TABLE_BYTES, so it stays resident in L1 next to D.
+ *
+ * Usage:
+ *   rcpa::TailGenerator<13, uint8_t> gen;
+ *   gen.for_each_ring([&](const uint8_t* ring) { ... });
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_TAIL_HPP
+#define RCPA_TAIL_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "rcpa_simd.hpp"
+
+#ifndef RCPA_TAIL_TABLE_BYTES
+#define RCPA_TAIL_TABLE_BYTES (16 * 1024)
+#endif
+
+namespace rcpa {
+
+// --- Tail Tables ---
+
+// Gather row width: N indices ([B, N-2, N-1]) padded to 16-byte controls.
+template <int N>
+constexpr int tail_stride() { return ((N + 15) / 16) * 16; }
+
+// Tail blocks for K levels: (N-2)! / (N-2-K)!.
+constexpr unsigned long long tail_blocks(int n, int k) {
+    unsigned long long blocks = 1;
+    for (int i = n - 2 - k + 1; i <= n - 2; i++) blocks *= static_cast<unsigned long long>(i);
+    return blocks;
+}
+
+// Deepest tail (at most N-3 levels) whose table fits RCPA_TAIL_TABLE_BYTES.
+template <int N>
+constexpr int tail_levels() {
+    int k = 1;
+    while (k < N - 3 && tail_blocks(N, k + 1) * tail_stride<N>() <= RCPA_TAIL_TABLE_BYTES) k++;
+    return k;
+}
+
+template <int N, int K>
+struct TailTable {
+    static_assert(K >= 1 && K <= N - 3, "tail depth out of range");
+    static const int P = N - 3 - K;  // parent row; the tail owns C[P+1 .. N-3]
+    static const int BLOCKS = static_cast<int>(tail_blocks(N, K));
+    static const int STRIDE = tail_stride<N>();
+
+    alignas(64) uint8_t idx[BLOCKS][STRIDE];
+
+    constexpr TailTable() : idx() {
+        for (int b = 0; b < BLOCKS; b++) {
+            // Digits of b: C[P+1] most significant, C[N-3] least.
+            int digit[N] = {};
+            int rest = b;
+            for (int i = N - 3; i > P; i--) {
+                digit[i] = rest % (i + 1);
+                rest /= (i + 1);
+            }
+            // Row P+1 as src indices, then rows P+2 .. N-3 and the window B.
+            int seq[N] = {};
+            int next[N] = {};
+            for (int t = 0; t < P + 2; t++) seq[t] = t;
+            for (int j = P + 2; j <= N - 2; j++) {
+                for (int t = 0; t < j; t++) next[t] = seq[(digit[j - 1] + t) % j];
+                next[j] = j;
+                for (int t = 0; t <= j; t++) seq[t] = next[t];
+            }
+            for (int t = 0; t < N - 2; t++) idx[b][t] = static_cast<uint8_t>(seq[t]);
+            // src[N-2] and src[N-1] hold the constants N-2 and N-1.
+            idx[b][N - 2] = static_cast<uint8_t>(N - 2);
+            idx[b][N - 1] = static_cast<uint8_t>(N - 1);
+        }
+    }
+};
+
+// Ring row layout as VPERMB control over [B, N-2, N-1]: P1 = [B, N-2, N-1],
+// P2 = [B, N-2] at N, P3 = [B] at 2N-1 (see load_ring() in rcpa.hpp).
+template <int N>
+struct TailRowLayout {
+    alignas(64) uint8_t pos[64];
+
+    constexpr TailRowLayout() : pos() {
+        for (int t = 0; t < 64; t++) {
+            int u = 0;
+            if (t < N) u = t;
+            else if (t < 2 * N - 1) u = t - N;
+            else if (t < 3 * N - 1) u = t - (2 * N - 1);
+            pos[t] = static_cast<uint8_t>(u);
+        }
+    }
+};
+
+#if RCPA_HAVE_DISPATCH
+#define RCPA_TAIL_SIMD 1
+#define RCPA_TARGET_TAIL_SSSE3 __attribute__((target("ssse3")))
+#define RCPA_TARGET_TAIL_AVX512 __attribute__((target("avx512bw,avx512vbmi")))
+#else
+#if defined(__SSSE3__)
+#define RCPA_TAIL_SIMD 1
+#else
+#define RCPA_TAIL_SIMD 0
+#endif
+#define RCPA_TARGET_TAIL_SSSE3
+#define RCPA_TARGET_TAIL_AVX512
+#endif
+
+#if RCPA_TAIL_SIMD
+#include <immintrin.h>
+
+// As for the bursts: always_inline only when the build enables the ISA.
+#if defined(__SSSE3__)
+#define RCPA_INLINE_TAIL_SSSE3 RCPA_INLINE
+#else
+#define RCPA_INLINE_TAIL_SSSE3 inline
+#endif
+#if defined(__AVX512VBMI__) && defined(__AVX512BW__)
+#define RCPA_INLINE_TAIL_AVX512 RCPA_INLINE
+#else
+#define RCPA_INLINE_TAIL_AVX512 inline
+#endif
+
+// D[0..15] = src[ctrl[0..15]].
+RCPA_INLINE_TAIL_SSSE3 RCPA_TARGET_TAIL_SSSE3 void tail_gather_pshufb(uint8_t* D, const uint8_t* src,
+                                                                      const uint8_t* ctrl) {
+    const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i c = _mm_load_si128(reinterpret_cast<const __m128i*>(ctrl));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(D), _mm_shuffle_epi8(s, c));
+}
+
+#if RCPA_HAVE_DISPATCH || (defined(__AVX512VBMI__) && defined(__AVX512BW__))
+// D[0..63] = ring row of src[ctrl[0..N-1]]: the layout shuffle is applied
+// to the gather control first, then one VPERMB builds the row.
+RCPA_INLINE_TAIL_AVX512 RCPA_TARGET_TAIL_AVX512 void tail_row_vpermb(uint8_t* D, const uint8_t* src,
+                                                                     const uint8_t* ctrl, const uint8_t* layout,
+                                                                     int n) {
+    const __mmask64 live = (n >= 64) ? ~0ull : ((1ull << n) - 1);
+    const __m512i s = _mm512_maskz_loadu_epi8(live, src);
+    const __m512i c = _mm512_maskz_loadu_epi8(live, ctrl);
+    const __m512i row_ctrl = _mm512_maskz_permutexvar_epi8(~0ull, _mm512_load_si512(layout), c);
+    _mm512_storeu_si512(D, _mm512_maskz_permutexvar_epi8(~0ull, row_ctrl, s));
+}
+#endif
+#endif
+
+// --- Tail Generator ---
+
+template <int N, typename T = int, Isa I = BUILD_ISA, int K = tail_levels<N>()>
+class TailGenerator {
+    static_assert(N > 3, "RCPA logic requires N > 3");
+    typedef TailTable<N, K> Table;
+    static const int P = Table::P;
+
+public:
+    typedef T value_type;
+
+    explicit TailGenerator(int = N) {}
+
+    static constexpr int size() { return N; }
+    static constexpr int tail_depth() { return K; }
+    unsigned long long count() const { return factorial(N); }
+
+    // Calls visit(const T* ring) once per ring state, in RCPA order.
+    template <class Visitor>
+    void for_each_ring(Visitor&& visit) {
+        static constexpr Table table;
+        reset();
+
+        int i_loop = 0;
+        for (;;) {
+            for (int j = i_loop + 1; j <= P; j++) cascade_row(j);
+            std::memcpy(src, row_ptr(P) + C[P], (P + 1) * sizeof(T));
+            RCPA_COUNT_OP(cascade_bytes, (P + 1) * sizeof(T));
+
+            for (int b = 0; b < Table::BLOCKS; b++) expand(table.idx[b], visit);
+
+            C[P]++;
+            for (i_loop = P; (i_loop > 0) && (C[i_loop] > i_loop); i_loop--) {
+                RCPA_COUNT_CARRY(i_loop);
+                C[i_loop] = 0;
+                C[i_loop - 1]++;
+            }
+            if (i_loop == 0) break;
+        }
+    }
+
+    // Calls visit(const T* perm) once for each of the N! permutations.
+    template <class Visitor>
+    void for_each(Visitor&& visit) {
+        for_each_ring([&](const T* ring) {
+            for (int h = 0; h < N; h++) visit(ring + h);
+        });
+    }
+
+private:
+    RCPA_INLINE T* row_ptr(int i) { return rows + i * (2 * N); }
+
+    void reset() {
+        std::memset(rows, 0, sizeof(rows));
+        std::memset(src, 0, sizeof(src));
+        std::memset(D, 0, sizeof(D));
+        for (int i = 0; i <= P; i++) {
+            C[i] = 0;
+            T* row = row_ptr(i);
+            for (int j = 0; j < i; j++) {
+                row[j] = static_cast<T>(j);
+                row[j + i + 1] = static_cast<T>(j);
+            }
+            row[i] = static_cast<T>(i);
+        }
+        for (int q = P + 1; q < N; q++) src[q] = static_cast<T>(q);
+    }
+
+    // Rows 1..P as in rcpa.hpp: window of row j-1 at C[j-1], pivot, mirror.
+    RCPA_INLINE void cascade_row(int j) {
+        const T* src_ptr = row_ptr(j - 1) + C[j - 1];
+        T* row = row_ptr(j);
+        std::memcpy(row, src_ptr, j * sizeof(T));
+        std::memcpy(row + j + 1, src_ptr, j * sizeof(T));
+        RCPA_COUNT_OP(cascade_bytes, 2 * j * sizeof(T));
+    }
+
+    // One tail block: ring row from the gather control, then its N-1 states.
+    template <class Visitor>
+    RCPA_INLINE void expand(const uint8_t* ctrl, Visitor& visit) {
+#if RCPA_TAIL_SIMD
+        if constexpr (std::is_same<T, uint8_t>::value && 3 * N - 1 <= 64 && I == Isa::Avx512) {
+            static constexpr TailRowLayout<N> layout;
+            tail_row_vpermb(D, src, ctrl, layout.pos, N);
+            RCPA_COUNT_OP(cascade_bytes, (3 * N - 1) * sizeof(T));
+            RCPA_COUNT_OP(ring_updates, N - 1);
+            RCPA_COUNT_OP(perms, N * (N - 1));
+            T* target = &D[N - 1];
+            #pragma GCC unroll 16
+            for (int ring_index = 0; ring_index < N - 1; ring_index++) {
+                visit(static_cast<const T*>(D + ring_index));
+                *target = *(target + 1);
+                *(target + 1) = static_cast<T>(N - 1);
+                target++;
+            }
+            return;
+        }
+        if constexpr (std::is_same<T, uint8_t>::value && N <= 16 && I != Isa::Scalar) {
+            tail_gather_pshufb(D, src, ctrl);
+            RCPA_COUNT_OP(cascade_bytes, (N - 2) * sizeof(T));
+            BurstScalar::run<N>(D, visit);
+            return;
+        }
+#endif
+        #pragma GCC unroll 32
+        for (int t = 0; t < N - 2; t++) D[t] = src[ctrl[t]];
+        RCPA_COUNT_OP(cascade_bytes, (N - 2) * sizeof(T));
+        BurstScalar::run<N>(D, visit);
+    }
+
+    int C[P + 1];
+    alignas(64) T rows[(P + 1) * 2 * N];
+    alignas(64) T src[N + 64];
+    alignas(64) T D[3 * N + RCPA_BURST_PAD];
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_TAIL_HPP
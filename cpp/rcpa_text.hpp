@@ -0,0 +1,181 @@
+/**
+ * @file    rcpa_text.hpp
+ * @brief   Fast text output of permutations: digit tables + writev.
+ * @author  YUSHENG-HU
+ * @details
+ * printf("%d ") per element costs far more than generating the permutation,
+ * which is why the benchmarks only print for n <= LITTLE_NUMBER. TextWriter
+ * formats each value 0..N-1 once into an 8-byte table slot ("12 " or "12,"),
+ * so a line is N fixed-size 8-byte copies; the separator after the last
+ * element becomes '\n'. Lines go into a ring of chunk buffers, and all full
+ * chunks are written with one writev(2) call. Any N up to 100000 works.
+ *
+ *   rcpa::TextWriter text(n, ',');           // stdout, "0,1,2,3\n"
+ *   generator.for_each([&](const T* perm) { text.line(perm); });
+ *   text.flush();
+ *
+ * Output bypasses stdio, so fflush(stdout) before the first line (the
+ * constructor does) and flush() before the next printf. Element values must
+ * lie in 0..N-1.
+ *
+ * License: MIT License
+ * Copyright (c) 2026 YUSHENG-HU
+ */
+
+#ifndef RCPA_TEXT_HPP
+#define RCPA_TEXT_HPP
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace rcpa {
+
+// "space" or "comma" (the value of a --text= flag).
+inline bool parse_text_separator(const char* name, char& sep) {
+    if (std::strcmp(name, "space") == 0) sep = ' ';
+    else if (std::strcmp(name, "comma") == 0) sep = ',';
+    else return false;
+    return true;
+}
+
+class TextWriter {
+public:
+    static const int SLOT = 8;              // bytes per digit-table entry
+    static const int CHUNKS = 8;            // buffers per writev
+    static const size_t CHUNK_BYTES = 256 * 1024;
+
+    explicit TextWriter(int n, char sep = ' ', int fd = 1)
+        : n_(n), fd_(fd), chunk_(0), pos_(0), bytes_(0), ok_(true),
+          table_(static_cast<size_t>(n) * SLOT, 0), len_(n, 0) {
+        for (int v = 0; v < n; v++) {
+            char digits[8];
+            int d = 0;
+            int x = v;
+            do {
+                digits[d++] = static_cast<char>('0' + x % 10);
+                x /= 10;
+            } while (x > 0);
+            char* slot = &table_[static_cast<size_t>(v) * SLOT];
+            for (int k = 0; k < d; k++) slot[k] = digits[d - 1 - k];
+            slot[d] = sep;
+            len_[v] = static_cast<unsigned char>(d + 1);
+        }
+        // One line plus a full slot of overrun must fit behind any position.
+        line_max_ = static_cast<size_t>(n) * SLOT + SLOT;
+        cap_ = CHUNK_BYTES > line_max_ ? CHUNK_BYTES : line_max_;
+        buf_.resize(CHUNKS);
+        for (int c = 0; c < CHUNKS; c++) buf_[c].resize(cap_ + line_max_);
+        fill_[0] = 0;
+        fflush(stdout);
+    }
+
+    ~TextWriter() { flush(); }
+
+    // Appends "p0<sep>p1<sep>...p(N-1)\n".
+    template <typename T>
+    inline void line(const T* perm) {
+        char* out = &buf_[chunk_][pos_];
+        const char* table = &table_[0];
+        for (int k = 0; k < n_; k++) {
+            const unsigned v = static_cast<unsigned>(perm[k]);
+            std::memcpy(out, table + static_cast<size_t>(v) * SLOT, SLOT);
+            out += len_[v];
+        }
+        out[-1] = '\n';
+        pos_ = static_cast<size_t>(out - &buf_[chunk_][0]);
+        if (pos_ >= cap_) next_chunk();
+    }
+
+    // Writes everything buffered so far; false after any write error.
+    bool flush() {
+        fill_[chunk_] = pos_;
+        write_chunks(chunk_ + 1);
+        chunk_ = 0;
+        pos_ = 0;
+        return ok_;
+    }
+
+    unsigned long long bytes() const { return bytes_ + pos_; }
+    bool ok() const { return ok_; }
+
+private:
+    void next_chunk() {
+        fill_[chunk_] = pos_;
+        pos_ = 0;
+        if (++chunk_ == CHUNKS) {
+            write_chunks(CHUNKS);
+            chunk_ = 0;
+        }
+    }
+
+    void write_chunks(int count) {
+        for (int c = 0; c < count; c++) bytes_ += fill_[c];
+        if (!ok_) return;
+#ifdef _WIN32
+        for (int c = 0; c < count && ok_; c++) {
+            const char* p = &buf_[c][0];
+            size_t left = fill_[c];
+            while (left > 0) {
+                int w = _write(fd_, p, static_cast<unsigned>(left));
+                if (w <= 0) {
+                    ok_ = false;
+                    break;
+                }
+                p += w;
+                left -= static_cast<size_t>(w);
+            }
+        }
+#else
+        iovec iov[CHUNKS];
+        int first = 0;
+        for (int c = 0; c < count; c++) {
+            iov[c].iov_base = &buf_[c][0];
+            iov[c].iov_len = fill_[c];
+        }
+        // writev may stop short (pipes, signals): resume from where it did.
+        while (first < count) {
+            ssize_t w = writev(fd_, iov + first, count - first);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                ok_ = false;
+                return;
+            }
+            size_t done = static_cast<size_t>(w);
+            while (first < count && done >= iov[first].iov_len) {
+                done -= iov[first].iov_len;
+                first++;
+            }
+            if (first < count) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + done;
+                iov[first].iov_len -= done;
+            }
+        }
+#endif
+    }
+
+    int n_;
+    int fd_;
+    int chunk_;
+    size_t pos_;
+    size_t cap_;
+    size_t line_max_;
+    unsigned long long bytes_;
+    bool ok_;
+    std::vector<char> table_;
+    std::vector<unsigned char> len_;
+    std::vector<std::vector<char> > buf_;
+    size_t fill_[CHUNKS];
+};
+
+}  // namespace rcpa
+
+#endif  // RCPA_TEXT_HPP